@@ -0,0 +1,511 @@
+/**
+ * @file Bench.cpp
+ * @brief Micro and macro benchmarks of the game: point arithmetic and its batched movement kernel, nearest fighter
+ * searches (per fighter and with the vectorized kernel), a single attack round and whole battles of every team strategy at roster sizes 10, 1k and 100k.
+ * Every benchmark reports nanoseconds and heap allocations per operation, recorded battles also their overhead
+ * over the same battles unrecorded. The results are printed as a table and written as JSON (to bench_output.json
+ * unless another path is given), so runs of different releases can be compared.
+ * Usage: ./bench [--filter <substring>] [--output <path>]
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "sources/Team.hpp"
+#include "sources/BattleRunner.hpp"
+#include "sources/FighterArena.hpp"
+#include "sources/NearestKernel.hpp"
+#include "sources/MoveKernel.hpp"
+#include "sources/BattleSnapshot.hpp"
+#include "sources/FreeForAll.hpp"
+#include "sources/Tournament.hpp"
+#include "sources/ShardedBattle.hpp"
+#include "sources/RosterGenerator.hpp"
+
+using namespace ariel;
+using namespace std;
+
+//<--------------------Allocation counting-------------------->
+namespace {
+    std::atomic<std::size_t> allocationCount{0};
+}
+
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+//<-------------------------------------------------->
+
+namespace {
+
+    const double MIN_MEASURED_SECONDS = 0.2;
+    const double MAX_WALL_SECONDS = 5.0;
+    const std::size_t POINT_BATCH = 1024;
+    const std::vector<std::size_t> ROSTER_SIZES = {10, 1000, 100000};
+    // Caps the battles that a strategy cannot finish, a capped battle is still timed in full.
+    const int BATTLE_ROUNDS = 300;
+    // The teams of the free-for-all benchmark, which is skipped when they would field more fighters than this.
+    const std::size_t FFA_TEAMS = 128;
+    const std::size_t FFA_MAX_FIGHTERS = 200000;
+    // The rosters of the tournament benchmark, each entered with the three strategies, and its battles per pairing.
+    const std::size_t TOURNAMENT_ROSTERS = 64;
+    const std::size_t TOURNAMENT_BATTLES = 2;
+    // The roster sizes of the sharded battle benchmark, up to a million fighters per side.
+    const std::vector<std::size_t> SHARDED_SIZES = {1000, 100000, 1000000};
+
+    struct Result {
+        std::string name;
+        std::size_t roster;
+        std::size_t iterations;
+        double nsPerOp;
+        double allocationsPerOp;
+    };
+
+    // Keeps the compiler from discarding a computed value.
+    template<typename T>
+    void keep(const T &value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    void printHeader() {
+        std::cout << std::left << std::setw(30) << "benchmark" << std::right << std::setw(8) << "roster"
+                  << std::setw(12) << "iterations" << std::setw(16) << "ns/op" << std::setw(14) << "allocs/op"
+                  << std::endl;
+    }
+
+    void printRow(const Result &result) {
+        std::cout << std::left << std::setw(30) << result.name << std::right << std::setw(8) << result.roster
+                  << std::setw(12) << result.iterations << std::setw(16) << std::fixed << std::setprecision(1)
+                  << result.nsPerOp << std::setw(14) << std::setprecision(2) << result.allocationsPerOp << std::endl;
+    }
+
+    // The extra time a benchmark takes over another one at the same roster size.
+    struct Overhead {
+        std::string name;
+        std::string baseline;
+        std::size_t roster;
+        double percent;
+    };
+
+    // Benchmarks whose name contains this are run, the others are skipped.
+    std::string filter;
+    std::vector<Result> results;
+    std::vector<Overhead> overheads;
+
+    /**
+     * @brief Runs an operation until it was measured for long enough, timing only the operation itself,
+     * and records the result. Nothing happens if the name does not match the filter.
+     * @param name The name of the benchmark.
+     * @param roster The roster size the benchmark works on, 0 if it has none.
+     * @param opsPerCall The number of operations performed by a single call of op.
+     * @param setup Prepares the state of the next call of op, not measured.
+     * @param op The measured operation.
+     */
+    void measure(const std::string &name, std::size_t roster, std::size_t opsPerCall,
+                 const std::function<void()> &setup, const std::function<void()> &op) {
+        if (name.find(filter) == std::string::npos) {
+            return;
+        }
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point wallStart = Clock::now();
+        double measuredSeconds = 0;
+        std::size_t allocations = 0;
+        std::size_t calls = 0;
+        while (calls == 0 || (measuredSeconds < MIN_MEASURED_SECONDS &&
+                              std::chrono::duration<double>(Clock::now() - wallStart).count() < MAX_WALL_SECONDS)) {
+            setup();
+            std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            Clock::time_point start = Clock::now();
+            op();
+            Clock::time_point end = Clock::now();
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            measuredSeconds += std::chrono::duration<double>(end - start).count();
+            calls++;
+        }
+        double ops = static_cast<double>(calls * opsPerCall);
+        results.push_back(Result{name, roster, calls * opsPerCall, measuredSeconds * 1e9 / ops,
+                                 static_cast<double>(allocations) / ops});
+        printRow(results.back());
+    }
+
+    /**
+     * @brief Measures an operation like measure(), alternating every call with a call of the baseline operation it
+     * extends, and records how much slower it ran than the baseline. Alternating keeps the comparison fair when the
+     * speed of the machine drifts between benchmarks. Nothing happens if the name does not match the filter.
+     * @param name The name of the benchmark.
+     * @param baseline The name of the baseline, e.g. the benchmark it extends.
+     * @param roster The roster size the benchmark works on.
+     * @param baseOp The baseline operation, timed for the comparison only.
+     * @param op The measured operation.
+     */
+    void measureOverhead(const std::string &name, const std::string &baseline, std::size_t roster,
+                         const std::function<void()> &baseOp, const std::function<void()> &op) {
+        if (name.find(filter) == std::string::npos) {
+            return;
+        }
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point wallStart = Clock::now();
+        double baseSeconds = 0;
+        double measuredSeconds = 0;
+        std::size_t allocations = 0;
+        std::size_t calls = 0;
+        while (calls == 0 || (measuredSeconds < MIN_MEASURED_SECONDS &&
+                              std::chrono::duration<double>(Clock::now() - wallStart).count() < MAX_WALL_SECONDS)) {
+            Clock::time_point start = Clock::now();
+            baseOp();
+            Clock::time_point middle = Clock::now();
+            std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            op();
+            Clock::time_point end = Clock::now();
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            baseSeconds += std::chrono::duration<double>(middle - start).count();
+            measuredSeconds += std::chrono::duration<double>(end - middle).count();
+            calls++;
+        }
+        double ops = static_cast<double>(calls);
+        results.push_back(Result{name, roster, calls, measuredSeconds * 1e9 / ops,
+                                 static_cast<double>(allocations) / ops});
+        printRow(results.back());
+        overheads.push_back(Overhead{name, baseline, roster, (measuredSeconds / baseSeconds - 1.0) * 100.0});
+        std::cout << std::left << std::setw(30) << "  vs " + baseline << std::right << std::setw(8)
+                  << roster << std::setw(27) << std::showpos << std::fixed << std::setprecision(1)
+                  << overheads.back().percent << std::noshowpos << '%' << std::endl;
+    }
+
+    /**
+     * @brief Lays out a roster on a square grid with the four unit types taking turns.
+     * @param type The strategy of the team.
+     * @param size The number of fighters.
+     * @param originX The x coordinate of the left column of the grid.
+     * @return The roster, its first fighter being the leader.
+     */
+    TeamSpec gridRoster(TeamType type, std::size_t size, double originX) {
+        const UnitType units[] = {UnitType::Cowboy, UnitType::YoungNinja, UnitType::TrainedNinja, UnitType::OldNinja};
+        const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(size))));
+        TeamSpec spec{type, {}};
+        spec.roster.reserve(size);
+        for (std::size_t i = 0; i < size; i++) {
+            spec.roster.push_back(FighterSpec{units[i % 4], "Bob", originX + 2.0 * static_cast<double>(i % side),
+                                              2.0 * static_cast<double>(i / side)});
+        }
+        return spec;
+    }
+
+    /**
+     * @brief A battle between a team of the given strategy and a plain Team standing next to it.
+     * @param type The strategy of team A.
+     * @param size The number of fighters on each side.
+     * @return The scenario.
+     */
+    Scenario battleScenario(TeamType type, std::size_t size) {
+        const double width = 2.0 * std::ceil(std::sqrt(static_cast<double>(size)));
+        Scenario scenario{gridRoster(type, size, 0.0), gridRoster(TeamType::Team, size, width + 10.0)};
+        scenario.maxRounds = BATTLE_ROUNDS;
+        return scenario;
+    }
+
+    /**
+     * @brief Builds a team of a scenario roster inside an arena.
+     * @param spec The roster.
+     * @param arena The arena of the fighters.
+     * @return The team.
+     */
+    std::unique_ptr<Team> buildTeam(const TeamSpec &spec, FighterArena &arena) {
+        std::unique_ptr<Team> team = createTeam(spec.type, createFighter(spec.roster.front(), arena),
+                                                std::max(Team::MAX_FIGHTERS, spec.roster.size()));
+        for (std::size_t i = 1; i < spec.roster.size(); i++) {
+            team->add(createFighter(spec.roster[i], arena));
+        }
+        return team;
+    }
+
+    /**
+     * @brief Creates an empty file of a unique name in the temporary directory, so that concurrent runs of the
+     * benchmarks don't write to each other's files.
+     * @param prefix The beginning of the name of the file.
+     * @return The path of the file, to be removed by the caller.
+     */
+    std::string temporaryFile(const std::string &prefix) {
+        std::string path = (std::filesystem::temp_directory_path() / (prefix + "_XXXXXX")).string();
+        int descriptor = mkstemp(path.data());
+        if (descriptor == -1) {
+            throw std::runtime_error("Error: Cannot create a temporary file in " + path + ".");
+        }
+        close(descriptor);
+        return path;
+    }
+
+    void pointBenchmarks() {
+        std::vector<Point> points;
+        for (std::size_t i = 0; i < POINT_BATCH; i++) {
+            points.emplace_back(static_cast<double>(i % 37) * 1.5, static_cast<double>(i % 91) * 0.5);
+        }
+        measure("Point::distance", 0, POINT_BATCH, [] {}, [&] {
+            double total = 0;
+            for (std::size_t i = 0; i < POINT_BATCH; i++) {
+                total += points[i].distance(points[POINT_BATCH - 1 - i]);
+            }
+            keep(total);
+        });
+        measure("Point::moveTowards", 0, POINT_BATCH, [] {}, [&] {
+            double total = 0;
+            for (std::size_t i = 0; i < POINT_BATCH; i++) {
+                total += Point::moveTowards(points[i], points[POINT_BATCH - 1 - i], 3.0).getX();
+            }
+            keep(total);
+        });
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> targetXs;
+        std::vector<double> targetYs;
+        std::vector<int> speeds(POINT_BATCH, 3);
+        for (std::size_t i = 0; i < POINT_BATCH; i++) {
+            targetXs.push_back(points[POINT_BATCH - 1 - i].getX());
+            targetYs.push_back(points[POINT_BATCH - 1 - i].getY());
+        }
+        measure("MoveKernel::advance", 0, POINT_BATCH, [&] {
+            xs.clear();
+            ys.clear();
+            for (const Point &point: points) {
+                xs.push_back(point.getX());
+                ys.push_back(point.getY());
+            }
+        }, [&] {
+            MoveKernel::advance(xs.data(), ys.data(), targetXs.data(), targetYs.data(), speeds.data(), POINT_BATCH);
+            keep(xs.front());
+        });
+    }
+
+    void teamBenchmarks(std::size_t size) {
+        FighterArena arena;
+        std::unique_ptr<Team> teamA;
+        std::unique_ptr<Team> teamB;
+        Scenario scenario = battleScenario(TeamType::Team, size);
+        auto rebuild = [&] {
+            teamA.reset();
+            teamB.reset();
+            arena.reset();
+            teamA = buildTeam(scenario.teamA, arena);
+            teamB = buildTeam(scenario.teamB, arena);
+        };
+
+        rebuild();
+        const Point probe(-5.0, 7.0);
+        measure("Team::findClosestCharacter", size, 1, [] {}, [&] {
+            keep(teamA->findClosestCharacter(probe, teamA->getFighters()));
+        });
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<int> alive;
+        for (const Character *fighter: teamA->getFighters()) {
+            xs.push_back(fighter->getLocation().getX());
+            ys.push_back(fighter->getLocation().getY());
+            alive.push_back(fighter->getHitPoints());
+        }
+        measure("NearestKernel::nearest", size, 1, [] {}, [&] {
+            keep(NearestKernel::nearest(xs.data(), ys.data(), alive.data(), size, probe.getX(), probe.getY()));
+        });
+        measure("Team::attack", size, 1, rebuild, [&] {
+            teamA->attack(teamB.get());
+        });
+        std::ofstream sink("/dev/null");
+        measure("Team::print", size, 1, [] {}, [&] {
+            teamA->print(sink);
+        });
+        rebuild();
+        BattleSnapshot snapshot(*teamA, *teamB);
+        measure("BattleSnapshot::capture", size, 1, [] {}, [&] {
+            snapshot.capture(*teamA, *teamB);
+            keep(snapshot.bytes());
+        });
+        measure("BattleSnapshot::restore", size, 1, [] {}, [&] {
+            snapshot.restore(*teamA, *teamB);
+            keep(teamA->stillAlive());
+        });
+        teamA.reset();
+        teamB.reset();
+
+        const std::pair<const char *, TeamType> strategies[] = {{"battle/Team",      TeamType::Team},
+                                                                {"battle/Team2",     TeamType::Team2},
+                                                                {"battle/SmartTeam", TeamType::SmartTeam}};
+        for (const auto &strategy: strategies) {
+            Scenario battle = battleScenario(strategy.second, size);
+            std::uint64_t seed = 0;
+            measure(strategy.first, size, 1, [] {}, [&] {
+                keep(BattleRunner::runBattle(battle, seed++, arena));
+            });
+        }
+        // Battles recorded to a log, each timed against the same battle unrecorded
+        const std::pair<const char *, TeamType> recorded[] = {{"battle/Team",       TeamType::Team},
+                                                              {"battle/PackedTeam", TeamType::PackedTeam}};
+        for (const auto &strategy: recorded) {
+            Scenario battle = battleScenario(strategy.second, size);
+            std::uint64_t seed = 0;
+            const std::string path = temporaryFile("cvn_bench_replay");
+            {
+                ReplayRecorder recorder(path);
+                measureOverhead(std::string(strategy.first) + "+replay", strategy.first, size, [&] {
+                    keep(BattleRunner::runBattle(battle, seed, arena));
+                }, [&] {
+                    keep(BattleRunner::runBattle(battle, seed++, arena, &recorder));
+                });
+            }
+            std::remove(path.c_str());
+        }
+
+        if (size * FFA_TEAMS <= FFA_MAX_FIGHTERS) {
+            // The teams stand on a square lattice, every team hostile to all the others
+            const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(FFA_TEAMS))));
+            const double width = 2.0 * std::ceil(std::sqrt(static_cast<double>(size))) + 10.0;
+            std::vector<std::unique_ptr<Team>> teams;
+            std::unique_ptr<FreeForAll> battle;
+            auto restart = [&] {
+                battle.reset();
+                teams.clear();
+                arena.reset();
+                battle = std::make_unique<FreeForAll>();
+                for (std::size_t index = 0; index < FFA_TEAMS; index++) {
+                    TeamSpec spec = gridRoster(TeamType::Team, size, width * static_cast<double>(index % side));
+                    for (FighterSpec &fighter: spec.roster) {
+                        fighter.y += width * static_cast<double>(index / side);
+                    }
+                    teams.push_back(buildTeam(spec, arena));
+                    battle->join(teams.back().get());
+                }
+            };
+            restart();
+            measure("ffa/round", size, 1, [&] {
+                if (battle->standing() <= 1) {
+                    restart();
+                }
+            }, [&] {
+                keep(battle->round());
+            });
+            battle.reset();
+            teams.clear();
+        }
+    }
+
+    void tournamentBenchmarks() {
+        Tournament tournament;
+        for (std::size_t roster = 0; roster < TOURNAMENT_ROSTERS; roster++) {
+            tournament.addRoster(RosterGenerator(roster, 0, -30.0, 30.0).team(TeamType::Team, 10).roster);
+        }
+        TournamentRules rules;
+        rules.jitter = 1.0;
+        rules.maxRounds = BATTLE_ROUNDS;
+        // Timed per battle
+        const std::size_t entrants = TOURNAMENT_ROSTERS * rules.strategies.size();
+        const std::size_t battles = (entrants * (entrants - 1) / 2 -
+                                     TOURNAMENT_ROSTERS * rules.strategies.size() * (rules.strategies.size() - 1) / 2) *
+                                    TOURNAMENT_BATTLES;
+        std::uint64_t seed = 0;
+        measure("tournament/battle", 10, battles, [] {}, [&] {
+            keep(tournament.run(rules, TOURNAMENT_BATTLES, seed++).ratings);
+        });
+    }
+
+    void shardedBenchmarks() {
+        struct Mode {
+            const char *name;
+            ShardedBattle::DamageMode damage;
+            ShardedBattle::Resolution resolution;
+        };
+        const Mode modes[] = {
+                {"sharded/round",              ShardedBattle::DamageMode::TileBuffers,
+                        ShardedBattle::Resolution::Alternating},
+                {"sharded/round+atomic",       ShardedBattle::DamageMode::Atomic,
+                        ShardedBattle::Resolution::Alternating},
+                {"sharded/round+simultaneous", ShardedBattle::DamageMode::TileBuffers,
+                        ShardedBattle::Resolution::Simultaneous}};
+        for (std::size_t size: SHARDED_SIZES) {
+            Scenario scenario = battleScenario(TeamType::Team, size);
+            for (const Mode &mode: modes) {
+                ShardedBattle battle(0, mode.damage, mode.resolution);
+                battle.load(scenario, 0);
+                // Timed per round, both turns on every core
+                measure(mode.name, size, 1, [&] {
+                    if (battle.stillAlive(0) == 0 || battle.stillAlive(1) == 0) {
+                        battle.load(scenario, 0);
+                    }
+                }, [&] {
+                    keep(battle.play(battle.getRounds() + 1));
+                });
+            }
+        }
+    }
+
+    void writeJson(const std::string &path) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Error: Cannot write the benchmark results to " + path + ".");
+        }
+        out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result &result = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"roster\": "
+                << result.roster << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": "
+                << std::setprecision(6) << result.nsPerOp << ", \"allocs_per_op\": " << result.allocationsPerOp
+                << "}";
+        }
+        out << "\n  ],\n  \"overheads\": [";
+        for (std::size_t i = 0; i < overheads.size(); i++) {
+            const Overhead &overhead = overheads[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << overhead.name << "\", \"baseline\": \""
+                << overhead.baseline << "\", \"roster\": " << overhead.roster << ", \"percent\": "
+                << std::setprecision(3) << overhead.percent << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string output = "bench_output.json";
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (argument == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--output <path>]" << std::endl;
+            return 1;
+        }
+    }
+
+    printHeader();
+    pointBenchmarks();
+    for (std::size_t size: ROSTER_SIZES) {
+        teamBenchmarks(size);
+    }
+    tournamentBenchmarks();
+    shardedBenchmarks();
+    writeJson(output);
+    return 0;
+}
@@ -7,19 +7,38 @@
 #include "sources/Cowboy.hpp"
 #include "sources/Team.hpp"
 #include "sources/Team2.hpp"
+#include "sources/BattleRunner.hpp"
+#include "sources/PackedTeam.hpp"
+#include "sources/FighterArena.hpp"
+#include "sources/NearestKernel.hpp"
+#include "sources/MoveKernel.hpp"
+#include "sources/Xoshiro256.hpp"
+#include "sources/RosterGenerator.hpp"
+#include "sources/ReplayReader.hpp"
+#include "sources/BattleSnapshot.hpp"
+#include "sources/TargetHeap.hpp"
+#include "sources/SmartTeam.hpp"
+#include "sources/StrategyTeam.hpp"
+#include "sources/UnitStats.hpp"
+#include "sources/FreeForAll.hpp"
+#include "sources/Tournament.hpp"
+#include "sources/StaticGrid.hpp"
+#include "sources/ShardedBattle.hpp"
+#include <array>
+#include <cstdio>
 #include <random>
 #include <chrono>
 #include <iostream>
+#include <sstream>
 
 using namespace ariel;
 using namespace std;
 //<--------------------Helper Functions-------------------->
-//https://www.geeksforgeeks.org/generate-a-random-float-number-in-cpp/
-double random_float(double min = -100, double max = 100) {
-    std::default_random_engine generator(static_cast<unsigned long>(std::chrono::system_clock::now().time_since_epoch().count()));
-    std::uniform_real_distribution<double> distribution(min, max);
+// Every run places the randomly placed fighters at the same locations, so a failure can be replayed
+Xoshiro256 test_random(2023);
 
-    return distribution(generator);
+double random_float(double min = -100, double max = 100) {
+    return test_random.uniform(min, max);
 }
 
 auto create_yninja = [](double x = random_float(), double y = random_float()) {
@@ -98,6 +117,21 @@ TEST_SUITE("Point class tests") {
         CHECK_THROWS_AS(Point::moveTowards(p1, p2, -1),std::invalid_argument);
     }
 
+    TEST_CASE("Squared distance and comparison queries") {
+        CHECK_EQ(n2.distanceSquared(p1), 100);
+        CHECK_EQ(p2.distanceSquared(n3), 25);
+        CHECK_EQ(p1.distanceSquared(p1), 0);
+
+        CHECK(p1.closerThan(p2, n2));
+        CHECK_FALSE(p1.closerThan(n2, p2));
+        CHECK_FALSE(p1.closerThan(p2, p2));
+
+        CHECK(p1.withinRadius(Point{1.5, 1.5}, 1));
+        CHECK_FALSE(p1.withinRadius(Point{2, 1}, 1));
+        CHECK_FALSE(p1.withinRadius(p1, 0));
+        CHECK_FALSE(p1.withinRadius(p1, -1));
+    }
+
 }
 
 TEST_SUITE("Classes initialization tests and Team modification( add(),stillAlive() )") {
@@ -139,6 +173,20 @@ TEST_SUITE("Classes initialization tests and Team modification( add(),stillAlive
         CHECK(trained_ninja.isAlive());
     }
 
+    TEST_CASE("Characters carry the kind of their class") {
+        Cowboy cowboy{"Bob", Point{0, 0}};
+        YoungNinja young_ninja{"Bob", Point{0, 0}};
+        TrainedNinja trained_ninja{"Bob", Point{0, 0}};
+        OldNinja old_ninja{"Bob", Point{0, 0}};
+        CHECK_EQ(cowboy.getKind(), FighterKind::Cowboy);
+        CHECK_EQ(young_ninja.getKind(), FighterKind::Ninja);
+        CHECK_EQ(trained_ninja.getKind(), FighterKind::Ninja);
+        CHECK_EQ(old_ninja.getKind(), FighterKind::Ninja);
+
+        Cowboy copy{cowboy};
+        CHECK_EQ(copy.getKind(), FighterKind::Cowboy);
+    }
+
     TEST_CASE("Team initialization") {
         auto cowboy = create_cowboy(2, 3);
         auto ninja = create_yninja(2, 3);
@@ -429,6 +477,123 @@ TEST_SUITE("Battle related methods") {
         delete oninja;
         delete tninja;
     }
+
+    TEST_CASE("The try variants report what the throwing methods throw") {
+        auto cowboy = create_cowboy(0, 0);
+        auto ninja = create_yninja(10, 0);
+        auto dead = create_tninja(0, 0.5);
+        dead->hit(120);
+
+        CHECK_EQ(cowboy->tryShoot(nullptr), CombatStatus::NullTarget);
+        CHECK_EQ(cowboy->tryShoot(cowboy), CombatStatus::SelfTarget);
+        CHECK_EQ(cowboy->tryShoot(dead), CombatStatus::TargetDead);
+        CHECK_EQ(cowboy->tryShoot(ninja), CombatStatus::Done);
+        CHECK_EQ(ninja->getHitPoints(), 90);
+        Cowboy deadCowboy{"Bob", Point{1, 1}};
+        deadCowboy.hit(110);
+        CHECK_EQ(deadCowboy.tryShoot(ninja), CombatStatus::AttackerDead);
+        CHECK_EQ(deadCowboy.tryReload(), CombatStatus::AttackerDead);
+        cowboy->setBullets(0);
+        CHECK_EQ(cowboy->tryShoot(ninja), CombatStatus::OutOfBullets);
+        CHECK_EQ(cowboy->tryReload(), CombatStatus::Done);
+        CHECK_EQ(dead->tryHit(-1), CombatStatus::InvalidAmount);
+
+        CHECK_EQ(ninja->trySlash(cowboy), CombatStatus::OutOfReach);
+        CHECK_EQ(ninja->trySlash(ninja), CombatStatus::SelfTarget);
+        CHECK_EQ(ninja->tryMove(cowboy), CombatStatus::Done);
+        CHECK_EQ(ninja->trySlash(cowboy), CombatStatus::Done);
+        CHECK_EQ(cowboy->getHitPoints(), 70);
+        CHECK_EQ(dead->tryMove(cowboy), CombatStatus::AttackerDead);
+        CHECK_EQ(ninja->tryMove(cowboy), CombatStatus::SamePosition);
+        CHECK_THROWS_AS(ninja->move(cowboy), std::invalid_argument);
+        CHECK_NOTHROW(dead->move(cowboy));
+        CHECK_FALSE(failed(CombatStatus::OutOfReach));
+        CHECK(failed(CombatStatus::TeamEliminated));
+
+        Team team{cowboy};
+        Team2 enemy{ninja};
+        enemy.add(dead);
+        CHECK_EQ(team.tryAttack(nullptr), CombatStatus::NullTarget);
+        CHECK_EQ(team.tryAttack(&team), CombatStatus::SelfTarget);
+        CHECK_THROWS_AS(team.attack(&team), std::runtime_error);
+        while (enemy.stillAlive()) {
+            CHECK_EQ(team.tryAttack(&enemy), CombatStatus::Done);
+        }
+        CHECK_EQ(team.tryAttack(&enemy), CombatStatus::TeamEliminated);
+        CHECK_EQ(enemy.tryAttack(&team), CombatStatus::TeamEliminated);
+        CHECK_THROWS_AS(enemy.attack(&team), std::runtime_error);
+    }
+
+    TEST_CASE("A volley matches one shot per cowboy") {
+        // One cowboy shooting at a time, the way attack() used to resolve the cowboys
+        auto one_by_one = [](Team &team, Team &enemy) {
+            Character *victim = enemy.closestAlive(team.getLeader()->getLocation());
+            for (Character *fighter: team.getFighters()) {
+                if (!victim->isAlive()) {
+                    victim = enemy.closestAlive(team.getLeader()->getLocation());
+                }
+                if (fighter->isAlive() && fighter->getKind() == FighterKind::Cowboy) {
+                    auto *cowboy = static_cast<Cowboy *>(fighter);
+                    if (cowboy->hasboolets()) {
+                        cowboy->shoot(victim);
+                    } else {
+                        cowboy->reload();
+                    }
+                }
+                if (enemy.stillAlive() == 0) {
+                    return static_cast<Character *>(nullptr);
+                }
+                if (!enemy.getLeader()->isAlive()) {
+                    enemy.setLeader(enemy.closestAlive(enemy.getLeader()->getLocation()));
+                }
+            }
+            // The ninjas would pick the next victim, a volley already did
+            return victim->isAlive() ? victim : enemy.closestAlive(team.getLeader()->getLocation());
+        };
+        auto fill = [](Team &team, Team &enemy) {
+            for (int i = 1; i < MAX_TEAM; i++) {
+                team.add(i % 4 == 0 ? static_cast<Character *>(create_yninja(0, i)) : create_cowboy(0, i));
+            }
+            // The enemy leader stands closest and dies in the first volley
+            enemy.add(create_yninja(6, 0));
+            enemy.add(create_cowboy(4, 6));
+            enemy.add(create_tninja(9, 2));
+            enemy.add(create_oninja(7, -3));
+        };
+        Team team{create_cowboy(0, 0)};
+        Team enemy{create_cowboy(5, 0)};
+        Team reference{create_cowboy(0, 0)};
+        Team referenceEnemy{create_cowboy(5, 0)};
+        fill(team, enemy);
+        fill(reference, referenceEnemy);
+
+        for (int round = 0; round < 12; round++) {
+            Character *victim = team.volley(&enemy);
+            Character *expected = one_by_one(reference, referenceEnemy);
+            CHECK_EQ(victim == nullptr, expected == nullptr);
+            for (std::size_t i = 0; i < enemy.getFighters().size(); i++) {
+                CHECK_EQ(enemy.getFighters()[i]->getHitPoints(), referenceEnemy.getFighters()[i]->getHitPoints());
+                if (enemy.getFighters()[i] == victim) {
+                    CHECK_EQ(referenceEnemy.getFighters()[i], expected);
+                }
+                if (enemy.getFighters()[i] == enemy.getLeader()) {
+                    CHECK_EQ(referenceEnemy.getFighters()[i], referenceEnemy.getLeader());
+                }
+            }
+            for (std::size_t i = 0; i < team.getFighters().size(); i++) {
+                if (team.getFighters()[i]->getKind() == FighterKind::Cowboy) {
+                    CHECK_EQ(static_cast<Cowboy *>(team.getFighters()[i])->getBullets(),
+                             static_cast<Cowboy *>(reference.getFighters()[i])->getBullets());
+                }
+            }
+            if (victim == nullptr) {
+                break;
+            }
+        }
+        CHECK_EQ(enemy.stillAlive(), 0);
+        CHECK_THROWS_AS(team.volley(&enemy), std::runtime_error);
+        CHECK_THROWS_AS(team.volley(nullptr), std::invalid_argument);
+    }
 }
 
 TEST_SUITE("Battle simulations") {
@@ -668,3 +833,1543 @@ TEST_SUITE("Battle simulations") {
         }
     }
 }
+
+TEST_SUITE("Battle runner") {
+
+    Scenario small_scenario() {
+        Scenario scenario;
+        scenario.teamA.type = TeamType::Team;
+        scenario.teamA.roster = {{UnitType::Cowboy,       "A1", 0,  0},
+                                 {UnitType::YoungNinja,   "A2", 1,  2},
+                                 {UnitType::OldNinja,     "A3", -2, 1}};
+        scenario.teamB.type = TeamType::Team2;
+        scenario.teamB.roster = {{UnitType::TrainedNinja, "B1", 20, 20},
+                                 {UnitType::Cowboy,       "B2", 22, 18},
+                                 {UnitType::Cowboy,       "B3", 19, 24}};
+        scenario.jitter = 5;
+        return scenario;
+    }
+
+    TEST_CASE("Every battle is accounted for exactly once") {
+        BattleRunner runner{2};
+        BattleReport report = runner.run(small_scenario(), 40, 7);
+        CHECK_EQ(report.battles, 40);
+        CHECK_EQ(report.winsA + report.winsB + report.draws, 40);
+        std::size_t counted = 0;
+        for (const auto &bucket: report.rounds.histogram) {
+            counted += bucket.second;
+        }
+        CHECK_EQ(counted, 40);
+        CHECK(report.rounds.min <= report.rounds.median);
+        CHECK(report.rounds.median <= report.rounds.max);
+    }
+
+    TEST_CASE("Reports do not depend on the number of threads") {
+        BattleRunner single{1};
+        BattleRunner several{4};
+        BattleReport first = single.run(small_scenario(), 64, 2023);
+        BattleReport second = several.run(small_scenario(), 64, 2023);
+        CHECK_EQ(first.winsA, second.winsA);
+        CHECK_EQ(first.winsB, second.winsB);
+        CHECK_EQ(first.rounds.histogram, second.rounds.histogram);
+        CHECK_EQ(first.survivingHitPointsA.histogram, second.survivingHitPointsA.histogram);
+        CHECK_EQ(first.survivingHitPointsB.histogram, second.survivingHitPointsB.histogram);
+    }
+
+    TEST_CASE("The random generator is fully determined by its seed and stream") {
+        // First outputs of the reference splitmix64 seeded with 0
+        std::uint64_t splitState = 0;
+        CHECK_EQ(Xoshiro256::splitMix(splitState), 0xE220A8397B1DCDAFULL);
+        CHECK_EQ(Xoshiro256::splitMix(splitState), 0x6E789E6AA1B965F4ULL);
+        CHECK_EQ(BattleRunner::battleSeed(5, 3), Xoshiro256::streamSeed(5, 3));
+
+        Xoshiro256 first{42, 1};
+        Xoshiro256 again{42, 1};
+        Xoshiro256 other{42, 2};
+        int different = 0;
+        for (int i = 0; i < 100; i++) {
+            std::uint64_t value = first();
+            CHECK_EQ(value, again());
+            different += value != other() ? 1 : 0;
+            double drawn = first.uniform(-3, 5);
+            CHECK(drawn >= -3);
+            CHECK(drawn < 5);
+            CHECK_EQ(drawn, again.uniform(-3, 5));
+            CHECK(first.below(7) < 7);
+            again.below(7);
+        }
+        CHECK(different > 90);
+        CHECK_THROWS_AS(first.below(0), std::invalid_argument);
+        Xoshiro256 jumped{42, 1};
+        jumped.jump();
+        CHECK_NE(jumped(), Xoshiro256{42, 1}());
+    }
+
+    TEST_CASE("Rosters generated on several threads match the ones generated on one") {
+        const std::size_t streams = 8;
+        std::vector<TeamSpec> serial;
+        for (std::size_t stream = 0; stream < streams; stream++) {
+            serial.push_back(RosterGenerator{99, stream}.team(TeamType::Team, 50));
+        }
+        std::vector<TeamSpec> parallel(streams);
+        WorkStealingPool pool{4};
+        pool.parallelFor(streams, [&](std::size_t stream, std::size_t) {
+            parallel[stream] = RosterGenerator{99, stream}.team(TeamType::Team, 50);
+        });
+        bool someDifferent = false;
+        for (std::size_t stream = 0; stream < streams; stream++) {
+            for (std::size_t i = 0; i < 50; i++) {
+                const FighterSpec &expected = serial[stream].roster[i];
+                const FighterSpec &actual = parallel[stream].roster[i];
+                CHECK_EQ(expected.type, actual.type);
+                CHECK_EQ(expected.x, actual.x);
+                CHECK_EQ(expected.y, actual.y);
+                CHECK(std::abs(actual.x) <= RosterGenerator::DEFAULT_BOUND);
+            }
+            someDifferent = someDifferent || serial[stream].roster[0].x != serial[0].roster[0].x;
+        }
+        CHECK(someDifferent);
+
+        Scenario scenario = RosterGenerator{7}.scenario(TeamType::Team, TeamType::PackedTeam, MAX_TEAM);
+        scenario.jitter = 2;
+        BattleRunner single{1};
+        BattleRunner several{3};
+        BattleReport first = single.run(scenario, 30, 11);
+        BattleReport second = several.run(scenario, 30, 11);
+        CHECK_EQ(first.rounds.histogram, second.rounds.histogram);
+        CHECK_EQ(first.survivingHitPointsA.histogram, second.survivingHitPointsA.histogram);
+        CHECK_THROWS_AS(RosterGenerator(1, 0, 5, 5), std::invalid_argument);
+        CHECK_THROWS_AS(RosterGenerator{1}.team(TeamType::Team, 0), std::invalid_argument);
+    }
+}
+
+TEST_SUITE("Packed teams") {
+
+    template<typename TeamType>
+    void fill_team(TeamType &team, double shift) {
+        team.add(create_cowboy(shift + 3, 1));
+        team.add(create_oninja(shift - 2, 4));
+        team.add(create_tninja(shift + 1, -3));
+        team.add(create_cowboy(shift - 4, -2));
+        team.add(create_yninja(shift + 2, 2));
+    }
+
+    void check_same_state(const Team &expected, const Team &actual) {
+        REQUIRE_EQ(expected.getFighters().size(), actual.getFighters().size());
+        for (std::size_t i = 0; i < expected.getFighters().size(); i++) {
+            const Character *first = expected.getFighters()[i];
+            const Character *second = actual.getFighters()[i];
+            CHECK_EQ(first->getHitPoints(), second->getHitPoints());
+            CHECK_EQ(first->getLocation().getX(), second->getLocation().getX());
+            CHECK_EQ(first->getLocation().getY(), second->getLocation().getY());
+        }
+        auto leader_slot = [](const Team &team) {
+            const auto &fighters = team.getFighters();
+            return std::find(fighters.begin(), fighters.end(), team.getLeader()) - fighters.begin();
+        };
+        CHECK_EQ(leader_slot(expected), leader_slot(actual));
+    }
+
+    TEST_CASE("A packed team fights exactly like a team") {
+        Team reference{create_yninja(0, 0)};
+        Team2 referenceEnemy{create_cowboy(15, 15)};
+        PackedTeam packed{create_yninja(0, 0)};
+        Team2 packedEnemy{create_cowboy(15, 15)};
+        fill_team(reference, 0);
+        fill_team(packed, 0);
+        fill_team(referenceEnemy, 15);
+        fill_team(packedEnemy, 15);
+
+        while (reference.stillAlive() && referenceEnemy.stillAlive()) {
+            reference.attack(&referenceEnemy);
+            packed.attack(&packedEnemy);
+            check_same_state(reference, packed);
+            check_same_state(referenceEnemy, packedEnemy);
+            if (referenceEnemy.stillAlive()) {
+                referenceEnemy.attack(&reference);
+                packedEnemy.attack(&packed);
+            }
+        }
+        CHECK_EQ(reference.stillAlive(), packed.stillAlive());
+        CHECK_EQ(referenceEnemy.stillAlive(), packedEnemy.stillAlive());
+    }
+
+    TEST_CASE("Two packed teams fight exactly like two teams") {
+        Team reference{create_yninja(0, 0)};
+        Team referenceEnemy{create_cowboy(15, 15)};
+        PackedTeam packed{create_yninja(0, 0)};
+        PackedTeam packedEnemy{create_cowboy(15, 15)};
+        fill_team(reference, 0);
+        fill_team(packed, 0);
+        fill_team(referenceEnemy, 15);
+        fill_team(packedEnemy, 15);
+
+        while (reference.stillAlive() && referenceEnemy.stillAlive()) {
+            reference.attack(&referenceEnemy);
+            packed.attack(&packedEnemy);
+            check_same_state(reference, packed);
+            check_same_state(referenceEnemy, packedEnemy);
+            CHECK_EQ(referenceEnemy.stillAlive(), packedEnemy.stillAlive());
+            if (referenceEnemy.stillAlive()) {
+                referenceEnemy.attack(&reference);
+                packedEnemy.attack(&packed);
+            }
+        }
+        CHECK_EQ(reference.stillAlive(), packed.stillAlive());
+    }
+
+    TEST_CASE("The fighters of a packed team are views of its store") {
+        FighterArena arena;
+        Cowboy *cowboy = arena.create<Cowboy>("C", Point{0, 0});
+        {
+            PackedTeam team{cowboy};
+            PackedTeam enemy{create_oninja(1, 1)};
+            team.attack(&enemy);
+            CHECK_EQ(enemy.getStore().hitPoints[0], enemy.getLeader()->getHitPoints());
+            CHECK_EQ(team.getStore().bullets[0], 5);
+            CHECK_EQ(cowboy->getBullets(), 5);
+            CHECK_THROWS_AS(team.attack(nullptr), std::invalid_argument);
+            CHECK_THROWS_AS(team.attack(&team), std::runtime_error);
+
+            cowboy->setHitPoints(40);
+            cowboy->setLocation(Point{2, 3});
+            CHECK_EQ(team.getStore().hitPoints[0], 40);
+            CHECK_EQ(team.getStore().x[0], 2);
+            Cowboy copy = *cowboy;
+            CHECK_EQ(copy.getBullets(), 5);
+            CHECK_EQ(copy.getHitPoints(), 40);
+        }
+        // The team gives its fighters their state back, an arena fighter outlives it
+        CHECK_EQ(cowboy->getHitPoints(), 40);
+        CHECK_EQ(cowboy->getBullets(), 5);
+        CHECK_EQ(cowboy->getLocation().getY(), 3);
+    }
+
+    template<typename TeamType>
+    void fill_grid(TeamType &team, int count, double shift) {
+        for (int i = 1; i < count; i++) {
+            double x = shift + (i % 37) * 1.5;
+            double y = (i / 37) * 1.5;
+            if (i % 3 == 0) {
+                team.add(create_cowboy(x, y));
+            } else if (i % 3 == 1) {
+                team.add(create_tninja(x, y));
+            } else {
+                team.add(create_yninja(x, y));
+            }
+        }
+    }
+
+    TEST_CASE("Teams can lift the ten fighters limit") {
+        Team team{create_cowboy(0, 0), 12};
+        for (int i = 0; i < 11; i++) {
+            team.add(create_cowboy(i, 1));
+        }
+        auto over = create_cowboy();
+        CHECK_THROWS_AS(team.add(over), std::runtime_error);
+        delete over;
+        CHECK_THROWS_AS(Team(create_cowboy(), 0), std::invalid_argument);
+        CHECK_EQ(Team{create_cowboy()}.getCapacity(), Team::MAX_FIGHTERS);
+    }
+
+    TEST_CASE("A large packed team fights exactly like a large team") {
+        Team reference{create_oninja(0, 0), Team::UNLIMITED};
+        Team2 referenceEnemy{create_cowboy(40, 0), Team::UNLIMITED};
+        PackedTeam packed{create_oninja(0, 0), Team::UNLIMITED};
+        Team2 packedEnemy{create_cowboy(40, 0), Team::UNLIMITED};
+        fill_grid(reference, 150, 0);
+        fill_grid(packed, 150, 0);
+        fill_grid(referenceEnemy, 150, 40);
+        fill_grid(packedEnemy, 150, 40);
+
+        while (reference.stillAlive() && referenceEnemy.stillAlive()) {
+            reference.attack(&referenceEnemy);
+            packed.attack(&packedEnemy);
+            if (referenceEnemy.stillAlive()) {
+                referenceEnemy.attack(&reference);
+                packedEnemy.attack(&packed);
+            }
+        }
+        check_same_state(reference, packed);
+        check_same_state(referenceEnemy, packedEnemy);
+    }
+
+    TEST_CASE("Large packed rosters fight a whole battle") {
+        PackedTeam team{create_cowboy(0, 0), Team::UNLIMITED};
+        PackedTeam team2{create_oninja(300, 0), Team::UNLIMITED};
+        fill_grid(team, 20000, 0);
+        fill_grid(team2, 20000, 300);
+        CHECK_EQ(team.stillAlive(), 20000);
+        simulate_battle(team, team2);
+        CHECK(((team.stillAlive() && !team2.stillAlive()) || (!team.stillAlive() && team2.stillAlive())));
+    }
+
+    TEST_CASE("The spatial index of a large team agrees with a plain scan") {
+        Team team{create_cowboy(0, 0), Team::UNLIMITED};
+        fill_grid(team, 200, 0);
+        const auto &fighters = team.getFighters();
+        auto agree = [&](double x, double y) {
+            Point location{x, y};
+            CHECK_EQ(team.closestAlive(location), team.findClosestCharacter(location, fighters));
+        };
+        for (int i = 0; i < 50; i++) {
+            agree(i * 1.5 - 20, (i % 7) * 3.0);
+        }
+        // Equidistant fighters: the first one in the roster wins
+        agree(0.75, 0);
+        agree(0.75, 0.75);
+
+        Cowboy shooter{"shooter", Point{-500, -500}};
+        for (std::size_t i = 0; i < fighters.size(); i += 3) {
+            while (fighters[i]->isAlive()) {
+                shooter.reload();
+                shooter.shoot(fighters[i]);
+            }
+        }
+        for (std::size_t i = 1; i < fighters.size(); i += 5) {
+            if (auto ninja = dynamic_cast<Ninja *>(fighters[i])) {
+                ninja->move(&shooter);
+            }
+        }
+        fighters[3]->setHitPoints(50);
+        for (int i = 0; i < 50; i++) {
+            agree(i * 1.5 - 20, (i % 7) * 3.0);
+            agree(-400 + i, -400 + i);
+        }
+
+        // Shooting whoever is closest to the same location, as a team does around its leader
+        Point far{-300, 7};
+        for (int i = 0; i < 40; i++) {
+            Character *closest = team.closestAlive(far);
+            CHECK_EQ(closest, team.findClosestCharacter(far, fighters));
+            closest->hit(200);
+        }
+        agree(-300, 7);
+    }
+
+    TEST_CASE("The alive count and live slots follow deaths and revivals") {
+        auto first = create_cowboy(0, 0);
+        auto second = create_oninja(1, 1);
+        auto third = create_yninja(2, 2);
+        Team team{first};
+        team.add(second);
+        team.add(third);
+        CHECK_EQ(team.getLiveSlots(), std::vector<std::size_t>{0, 1, 2});
+
+        second->hit(150);
+        CHECK_EQ(team.stillAlive(), 2);
+        CHECK_EQ(team.getLiveSlots(), std::vector<std::size_t>{0, 2});
+
+        second->setHitPoints(20);
+        third->setHitPoints(0);
+        CHECK_EQ(team.stillAlive(), 2);
+        CHECK_EQ(team.getLiveSlots(), std::vector<std::size_t>{0, 1});
+
+        auto late = create_cowboy(3, 3);
+        late->hit(110);
+        team.add(late);
+        team.add(create_tninja(4, 4));
+        CHECK_EQ(team.stillAlive(), 3);
+        CHECK_EQ(team.getLiveSlots(), std::vector<std::size_t>{0, 1, 4});
+    }
+
+    TEST_CASE("Assigning a character keeps its team's indexes in step") {
+        Team team{create_cowboy(0, 0), Team::UNLIMITED};
+        fill_grid(team, 100, 0);
+        const auto &fighters = team.getFighters();
+        auto *target = static_cast<Cowboy *>(fighters[9]);
+        Point far{-500, -500};
+        CHECK_NE(team.closestAlive(far), target);
+
+        Cowboy dead{"dead", Point{0, 0}};
+        dead.hit(110);
+        *target = dead;
+        CHECK_FALSE(target->isAlive());
+        CHECK_EQ(team.stillAlive(), 99);
+        CHECK(std::find(team.getLiveSlots().begin(), team.getLiveSlots().end(), 9) == team.getLiveSlots().end());
+
+        *target = Cowboy{"back", Point{-499, -499}};
+        CHECK(target->isAlive());
+        CHECK_EQ(team.stillAlive(), 100);
+        CHECK_EQ(team.closestAlive(far), target);
+        CHECK_EQ(team.closestAlive(far), team.findClosestCharacter(far, fighters));
+    }
+}
+
+TEST_SUITE("Fighter arena") {
+
+    TEST_CASE("Teams of arena fighters fight and leave the fighters to the arena") {
+        FighterArena arena;
+        std::size_t reserved = 0;
+        for (int battle = 0; battle < 3; battle++) {
+            {
+                Team team{arena.create<Cowboy>("Bob", Point{0, 0})};
+                Team2 team2{arena.create<OldNinja>("Bob", Point{5, 5})};
+                for (int i = 1; i < MAX_TEAM; i++) {
+                    team.add(arena.create<YoungNinja>("Bob", Point{static_cast<double>(i), 0}));
+                    team2.add(arena.create<Cowboy>("Bob", Point{5, static_cast<double>(i)}));
+                }
+                CHECK_EQ(arena.size(), 2 * MAX_TEAM);
+                CHECK_THROWS_AS(team.add(team2.getLeader()), std::runtime_error);
+                simulate_battle(team, team2);
+                CHECK((team.stillAlive() == 0 || team2.stillAlive() == 0));
+            }
+            arena.reset();
+            CHECK_EQ(arena.size(), 0);
+            if (battle == 0) {
+                reserved = arena.reservedBytes();
+            }
+            CHECK_EQ(arena.reservedBytes(), reserved);
+        }
+
+        Cowboy *cowboy = arena.create<Cowboy>("Bob", Point{0, 0});
+        Cowboy copy{*cowboy};
+        CHECK(cowboy->isArenaOwned());
+        CHECK_FALSE(copy.isArenaOwned());
+        CHECK_THROWS_AS(FighterArena{0}, std::invalid_argument);
+
+        // A fighter whose constructor throws leaves nothing for the arena to destroy
+        CHECK_THROWS_AS(arena.create<Cowboy>("", Point{0, 0}), std::invalid_argument);
+        CHECK_EQ(arena.size(), 1);
+        arena.reset();
+        CHECK_EQ(arena.size(), 0);
+    }
+}
+
+TEST_SUITE("Vectorized nearest search") {
+
+    TEST_CASE("Every kernel variant picks the first closest living candidate") {
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int> coordinate(-20, 20);
+        std::uniform_int_distribution<int> points(-5, 10);
+        for (std::size_t count: std::vector<std::size_t>{0, 1, 2, 3, 5, 8, 13, 64, 257}) {
+            std::vector<double> xs;
+            std::vector<double> ys;
+            std::vector<int> alive;
+            for (std::size_t i = 0; i < count; i++) {
+                // Integer coordinates make many equidistant candidates
+                xs.push_back(coordinate(generator));
+                ys.push_back(coordinate(generator));
+                alive.push_back(points(generator));
+            }
+            for (int probe = 0; probe < 20; probe++) {
+                double x = coordinate(generator);
+                double y = coordinate(generator);
+                std::size_t expected = NearestKernel::npos;
+                double best = std::numeric_limits<double>::max();
+                for (std::size_t i = 0; i < count; i++) {
+                    double squared = Point{x, y}.distanceSquared(Point{xs[i], ys[i]});
+                    if (alive[i] > 0 && squared < best) {
+                        best = squared;
+                        expected = i;
+                    }
+                }
+                for (auto level: {NearestKernel::Level::Scalar, NearestKernel::Level::SSE2,
+                                  NearestKernel::Level::AVX2}) {
+                    CHECK_EQ(NearestKernel::nearest(level, xs.data(), ys.data(), alive.data(), count, x, y), expected);
+                }
+                std::size_t first = count == 0 ? NearestKernel::npos : 0;
+                for (std::size_t i = 1; i < count; i++) {
+                    if (Point{x, y}.closerThan(Point{xs[i], ys[i]}, Point{xs[first], ys[first]})) {
+                        first = i;
+                    }
+                }
+                CHECK_EQ(NearestKernel::nearest(xs.data(), ys.data(), nullptr, count, x, y), first);
+            }
+        }
+    }
+
+    TEST_CASE("A team using the vectorized search agrees with a plain scan") {
+        Team team{create_cowboy(0, 0), Team::UNLIMITED};
+        for (int i = 1; i < 200; i++) {
+            Point location{(i % 37) * 1.5, (i / 37) * 1.5};
+            team.add(i % 2 == 0 ? static_cast<Character *>(create_cowboy(location.getX(), location.getY()))
+                                : create_tninja(location.getX(), location.getY()));
+        }
+        team.useVectorizedSearch(true);
+        CHECK(team.usesVectorizedSearch());
+        const auto &fighters = team.getFighters();
+        Point far{-300, 7};
+        for (int i = 0; i < 40; i++) {
+            Character *closest = team.closestAlive(far);
+            CHECK_EQ(closest, team.findClosestCharacter(far, fighters));
+            closest->hit(200);
+        }
+        for (std::size_t i = 1; i < fighters.size(); i += 5) {
+            if (fighters[i]->getKind() == FighterKind::Ninja && fighters[i]->isAlive()) {
+                static_cast<Ninja *>(fighters[i])->move(fighters[0]);
+            }
+        }
+        fighters[3]->setHitPoints(50);
+        team.add(create_yninja(0.5, 0.5));
+        for (int i = 0; i < 50; i++) {
+            Point location{i * 1.5 - 20, (i % 7) * 3.0};
+            CHECK_EQ(team.closestAlive(location), team.findClosestCharacter(location, fighters));
+        }
+    }
+}
+
+TEST_SUITE("Vectorized movement") {
+
+    TEST_CASE("Every kernel variant moves exactly like Point::moveTowards") {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<double> coordinate(-50, 50);
+        std::uniform_int_distribution<int> speed(0, 20);
+        for (std::size_t count: std::vector<std::size_t>{0, 1, 3, 4, 7, 64, 101}) {
+            std::vector<double> xs;
+            std::vector<double> ys;
+            std::vector<double> targetXs;
+            std::vector<double> targetYs;
+            std::vector<int> speeds;
+            for (std::size_t i = 0; i < count; i++) {
+                xs.push_back(coordinate(generator));
+                ys.push_back(coordinate(generator));
+                targetXs.push_back(coordinate(generator));
+                targetYs.push_back(coordinate(generator));
+                speeds.push_back(speed(generator));
+            }
+            if (count > 2) {
+                // A unit standing on its target stays there
+                targetXs[2] = xs[2];
+                targetYs[2] = ys[2];
+            }
+            for (auto level: {MoveKernel::Level::Scalar, MoveKernel::Level::SSE2, MoveKernel::Level::AVX2}) {
+                std::vector<double> movedX = xs;
+                std::vector<double> movedY = ys;
+                MoveKernel::advance(level, movedX.data(), movedY.data(), targetXs.data(), targetYs.data(),
+                                    speeds.data(), count);
+                for (std::size_t i = 0; i < count; i++) {
+                    if (count > 2 && i == 2) {
+                        CHECK_EQ(movedX[i], xs[i]);
+                        CHECK_EQ(movedY[i], ys[i]);
+                        continue;
+                    }
+                    Point expected = Point::moveTowards(Point{xs[i], ys[i]}, Point{targetXs[i], targetYs[i]},
+                                                        speeds[i]);
+                    CHECK_EQ(movedX[i], expected.getX());
+                    CHECK_EQ(movedY[i], expected.getY());
+                }
+            }
+        }
+    }
+}
+
+TEST_SUITE("Replay log") {
+
+    TEST_CASE("Every action of a team is recorded in order") {
+        const std::string path = "/tmp/cvn_replay_actions.bin";
+        auto *cowboy = new Cowboy("Tom", Point(0, 0));
+        auto *ninja = new YoungNinja("Sushi", Point(0, 5));
+        Team teamA{cowboy};
+        Team teamB{ninja};
+        {
+            ReplayRecorder recorder(path);
+            teamA.recordTo(&recorder, 0);
+            teamB.recordTo(&recorder, 1);
+            recorder.nextRound();
+            teamA.attack(&teamB);
+            teamB.attack(&teamA);
+            CHECK_EQ(recorder.size(), 2);
+        }
+        ReplayReader reader(path);
+        REQUIRE_EQ(reader.size(), 2);
+        const ReplayRecord &shot = reader[0];
+        CHECK_EQ(shot.round, 1);
+        CHECK_EQ(shot.event, ReplayEvent::Shoot);
+        CHECK_EQ(shot.team, 0);
+        CHECK_EQ(shot.actor, 0);
+        CHECK_EQ(shot.target, 0);
+        CHECK_EQ(shot.x, Cowboy::SHOT_DAMAGE);
+        CHECK_EQ(shot.y, ninja->getHitPoints());
+        const ReplayRecord &move = reader[1];
+        CHECK_EQ(move.event, ReplayEvent::Move);
+        CHECK_EQ(move.team, 1);
+        CHECK_EQ(move.x, ninja->getLocation().getX());
+        CHECK_EQ(move.y, ninja->getLocation().getY());
+        CHECK_THROWS_AS(reader[2], std::out_of_range);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("A recorded battle plays out like an unrecorded one and logs every death") {
+        const std::string path = "/tmp/cvn_replay_battle.bin";
+        RosterGenerator generator(15);
+        for (auto types: {std::make_pair(TeamType::Team, TeamType::Team2),
+                          std::make_pair(TeamType::SmartTeam, TeamType::Team),
+                          std::make_pair(TeamType::PackedTeam, TeamType::Team2)}) {
+            Scenario scenario = generator.scenario(types.first, types.second, 8);
+            BattleOutcome plain = BattleRunner::runBattle(scenario, 3);
+            FighterArena arena;
+            std::size_t recorded;
+            BattleOutcome replayed;
+            {
+                ReplayRecorder recorder(path);
+                replayed = BattleRunner::runBattle(scenario, 3, arena, &recorder);
+                recorder.flush();
+                recorded = recorder.size();
+                CHECK_EQ(recorder.getRound(), replayed.rounds);
+            }
+            CHECK_EQ(replayed.result, plain.result);
+            CHECK_EQ(replayed.rounds, plain.rounds);
+            CHECK_EQ(replayed.survivingHitPointsA, plain.survivingHitPointsA);
+            CHECK_EQ(replayed.survivingHitPointsB, plain.survivingHitPointsB);
+
+            ReplayReader reader(path);
+            CHECK_EQ(reader.size(), recorded);
+            std::size_t deaths[2] = {0, 0};
+            std::uint32_t round = 0;
+            for (const ReplayRecord &record: reader) {
+                CHECK(record.round >= round);
+                round = record.round;
+                REQUIRE(record.team < 2);
+                if (record.event == ReplayEvent::Death) {
+                    deaths[record.team]++;
+                } else if (record.event == ReplayEvent::Shoot) {
+                    CHECK_EQ(record.x, Cowboy::SHOT_DAMAGE);
+                } else if (record.event == ReplayEvent::Slash) {
+                    CHECK_EQ(record.x, Ninja::SLASH_DAMAGE);
+                }
+            }
+            CHECK(deaths[0] <= scenario.teamA.roster.size());
+            CHECK(deaths[1] <= scenario.teamB.roster.size());
+            if (replayed.result == BattleResult::TeamAWins) {
+                CHECK_EQ(deaths[1], scenario.teamB.roster.size());
+            } else if (replayed.result == BattleResult::TeamBWins) {
+                CHECK_EQ(deaths[0], scenario.teamA.roster.size());
+            }
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("A packed team records the same events as a team") {
+        const std::string path = "/tmp/cvn_replay_reference.bin";
+        const std::string packedPath = "/tmp/cvn_replay_packed.bin";
+        RosterGenerator generator(21);
+        // The large rosters fill more than the initial buffer in a round
+        for (std::size_t size: {std::size_t{12}, std::size_t{2500}}) {
+            for (TeamType enemyType: {TeamType::Team2, TeamType::PackedTeam}) {
+                Scenario reference = generator.scenario(TeamType::Team, TeamType::Team, size);
+                reference.teamB.type = enemyType == TeamType::PackedTeam ? TeamType::Team : enemyType;
+                Scenario packed = reference;
+                packed.teamA.type = TeamType::PackedTeam;
+                packed.teamB.type = enemyType;
+                for (const auto &run: {std::make_pair(&reference, &path), std::make_pair(&packed, &packedPath)}) {
+                    FighterArena arena;
+                    ReplayRecorder recorder(*run.second);
+                    BattleRunner::runBattle(*run.first, 5, arena, &recorder);
+                }
+                ReplayReader expected(path);
+                ReplayReader actual(packedPath);
+                REQUIRE_EQ(expected.size(), actual.size());
+                std::size_t mismatches = 0;
+                for (std::size_t i = 0; i < expected.size(); i++) {
+                    const ReplayRecord &first = expected[i];
+                    const ReplayRecord &second = actual[i];
+                    if (first.round != second.round || first.event != second.event || first.team != second.team ||
+                        first.actor != second.actor || first.target != second.target || first.x != second.x ||
+                        first.y != second.y) {
+                        mismatches++;
+                    }
+                }
+                CHECK_EQ(mismatches, 0);
+            }
+        }
+        std::remove(path.c_str());
+        std::remove(packedPath.c_str());
+    }
+
+    TEST_CASE("Only replay logs of this version can be read") {
+        const std::string path = "/tmp/cvn_replay_bad.bin";
+        CHECK_THROWS_AS(ReplayReader{"/tmp/cvn_replay_missing.bin"}, std::runtime_error);
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        REQUIRE(file != nullptr);
+        const char garbage[] = "certainly not a replay log";
+        std::fwrite(garbage, 1, sizeof(garbage), file);
+        std::fclose(file);
+        CHECK_THROWS_AS(ReplayReader{path}, std::runtime_error);
+        std::remove(path.c_str());
+        CHECK_THROWS_AS(ReplayRecorder{"/tmp/cvn_no_such_directory/replay.bin"}, std::runtime_error);
+    }
+}
+
+TEST_SUITE("Battle snapshots") {
+
+    std::unique_ptr<Team> build_team(const TeamSpec &spec) {
+        std::unique_ptr<Team> team = createTeam(spec.type, createFighter(spec.roster[0]), Team::UNLIMITED);
+        for (std::size_t i = 1; i < spec.roster.size(); i++) {
+            team->add(createFighter(spec.roster[i]));
+        }
+        return team;
+    }
+
+    // The hit points of every fighter after every round, until the battle ends
+    std::vector<int> play_out(Team &teamA, Team &teamB) {
+        std::vector<int> trace;
+        for (int round = 0; round < 200 && teamA.stillAlive() > 0 && teamB.stillAlive() > 0; round++) {
+            teamA.attack(&teamB);
+            if (teamB.stillAlive() > 0) {
+                teamB.attack(&teamA);
+            }
+            for (const Team *team: {&teamA, &teamB}) {
+                for (const Character *fighter: team->getFighters()) {
+                    trace.push_back(fighter->getHitPoints());
+                }
+            }
+        }
+        return trace;
+    }
+
+    TEST_CASE("A restored battle plays out exactly like the original") {
+        RosterGenerator generator(16);
+        for (auto types: {std::make_pair(TeamType::Team, TeamType::Team2),
+                          std::make_pair(TeamType::SmartTeam, TeamType::PackedTeam),
+                          std::make_pair(TeamType::Team2, TeamType::SmartTeam)}) {
+            Scenario scenario = generator.scenario(types.first, types.second, 12);
+            std::unique_ptr<Team> teamA = build_team(scenario.teamA);
+            std::unique_ptr<Team> teamB = build_team(scenario.teamB);
+            teamA->attack(teamB.get());
+            teamB->attack(teamA.get());
+
+            BattleSnapshot snapshot(*teamA, *teamB);
+            CHECK_EQ(snapshot.getStates().size(), 24);
+            CHECK_EQ(snapshot.bytes(), sizeof(SnapshotHeader) + 24 * sizeof(FighterState));
+            std::vector<int> original = play_out(*teamA, *teamB);
+
+            // A copy of the snapshot is as good as the snapshot
+            BattleSnapshot fork = snapshot;
+            fork.restore(*teamA, *teamB);
+            BattleSnapshot restored(*teamA, *teamB);
+            CHECK_EQ(restored.getHeader().leaderA, snapshot.getHeader().leaderA);
+            CHECK_EQ(restored.getHeader().leaderB, snapshot.getHeader().leaderB);
+            for (std::size_t i = 0; i < snapshot.getStates().size(); i++) {
+                const FighterState &expected = snapshot.getStates()[i];
+                const FighterState &actual = restored.getStates()[i];
+                CHECK_EQ(actual.x, expected.x);
+                CHECK_EQ(actual.y, expected.y);
+                CHECK_EQ(actual.hitPoints, expected.hitPoints);
+                CHECK_EQ(actual.bullets, expected.bullets);
+                CHECK_EQ(actual.speed, expected.speed);
+            }
+            CHECK_EQ(play_out(*teamA, *teamB), original);
+
+            // Restored into other teams of the same rosters
+            std::unique_ptr<Team> otherA = build_team(scenario.teamA);
+            std::unique_ptr<Team> otherB = build_team(scenario.teamB);
+            snapshot.restore(*otherA, *otherB);
+            CHECK_EQ(play_out(*otherA, *otherB), original);
+        }
+    }
+
+    TEST_CASE("Restoring revives the fallen and keeps the nearest searches right") {
+        RosterGenerator generator(17);
+        Scenario scenario = generator.scenario(TeamType::Team, TeamType::Team, 80);
+        std::unique_ptr<Team> teamA = build_team(scenario.teamA);
+        std::unique_ptr<Team> teamB = build_team(scenario.teamB);
+        Point probe = generator.location();
+        Character *closest = teamB->closestAlive(probe);
+        BattleSnapshot snapshot(*teamA, *teamB);
+        for (Character *fighter: teamB->getFighters()) {
+            fighter->hit(fighter->getHitPoints());
+        }
+        CHECK_EQ(teamB->stillAlive(), 0);
+        CHECK_EQ(teamB->closestAlive(probe), nullptr);
+        snapshot.restore(*teamA, *teamB);
+        CHECK_EQ(teamB->stillAlive(), 80);
+        CHECK_EQ(teamB->getLiveSlots().size(), 80);
+        CHECK_EQ(teamB->closestAlive(probe), closest);
+        CHECK_EQ(teamB->closestAlive(probe), teamB->findClosestCharacter(probe, teamB->getFighters()));
+    }
+
+    TEST_CASE("Snapshots are only restored into matching rosters") {
+        auto *cowboy = new Cowboy("Tom", Point(0, 0));
+        auto *ninja = new OldNinja("Sushi", Point(3, 4));
+        Team teamA{cowboy};
+        Team teamB{ninja};
+        BattleSnapshot snapshot(teamA, teamB);
+        Team larger{new Cowboy("Tim", Point(1, 1))};
+        larger.add(new Cowboy("Tam", Point(2, 2)));
+        CHECK_THROWS_AS(snapshot.restore(larger, teamB), std::invalid_argument);
+        Team otherKind{new YoungNinja("Yogi", Point(5, 5))};
+        CHECK_THROWS_AS(snapshot.restore(otherKind, teamB), std::invalid_argument);
+        CHECK_EQ(otherKind.getFighters()[0]->getLocation().getX(), 5);
+        cowboy->shoot(ninja);
+        snapshot.restore(teamA, teamB);
+        CHECK_EQ(cowboy->getBullets(), 6);
+        CHECK_EQ(ninja->getHitPoints(), 150);
+    }
+}
+
+TEST_SUITE("Printing") {
+
+    std::string concatenated(const Point &point) {
+        return "[" + std::to_string(point.getX()) + "," + std::to_string(point.getY()) + "]";
+    }
+
+    std::string concatenated(const Character *fighter) {
+        return (fighter->getKind() == FighterKind::Cowboy ? "C, " : " N, ") + std::string("name: ") +
+               fighter->getName() + ", HitPoints: " + std::to_string(fighter->getHitPoints()) + ", location: " +
+               concatenated(fighter->getLocation());
+    }
+
+    // Counts the flushes of the stream it is the buffer of
+    class FlushCounter : public std::stringbuf {
+    public:
+        int flushes = 0;
+
+    protected:
+        int sync() override {
+            flushes++;
+            return std::stringbuf::sync();
+        }
+    };
+
+    TEST_CASE("Buffered printing formats exactly like string concatenation") {
+        std::string buffer = "kept";
+        for (int i = 0; i < 200; i++) {
+            double scale = i % 4 == 0 ? 1e12 : 100;
+            Point point(random_float(-scale, scale), random_float(-scale, scale));
+            CHECK_EQ(point.print(), concatenated(point));
+            buffer.resize(4);
+            point.print(buffer);
+            CHECK_EQ(buffer, "kept" + concatenated(point));
+        }
+        CHECK_EQ(Point(-0.0, 1e300).print(), concatenated(Point(-0.0, 1e300)));
+
+        Cowboy cowboy("Tom", Point(random_float(), random_float()));
+        YoungNinja young("Yogi", Point(random_float(), random_float()));
+        TrainedNinja trained("Hikari", Point(-3.25, 0.5));
+        OldNinja old("Ancient ninja with a long name", Point(0, 0));
+        young.hit(37);
+        old.hit(150);
+        for (const Character *fighter: std::vector<const Character *>{&cowboy, &young, &trained, &old}) {
+            CHECK_EQ(fighter->print(), concatenated(fighter));
+            buffer.clear();
+            fighter->print(buffer);
+            CHECK_EQ(buffer, concatenated(fighter));
+        }
+    }
+
+    TEST_CASE("Teams print their living fighters with a single flush") {
+        auto expected = [](const Team &team, bool cowboysFirst) {
+            std::string text = "---------------------\nTeam " + team.getLeader()->getName() +
+                               "\n---------------------\nTeam Status: " +
+                               (team.stillAlive() ? "Alive" : "Defeated") + "\nNumber of Team members: " +
+                               std::to_string(team.stillAlive()) + "\nTeam Members:\n";
+            for (int pass = 0; pass < (cowboysFirst ? 2 : 1); pass++) {
+                for (const Character *fighter: team.getFighters()) {
+                    bool printed = !cowboysFirst ||
+                                   (fighter->getKind() == FighterKind::Cowboy) == (pass == 0);
+                    if (fighter->isAlive() && printed) {
+                        text += concatenated(fighter) + "\n";
+                    }
+                }
+            }
+            return text;
+        };
+        for (TeamType type: {TeamType::Team, TeamType::Team2, TeamType::SmartTeam}) {
+            std::unique_ptr<Team> team = createTeam(type, new YoungNinja("Leader", Point(1, 1)));
+            team->add(new Cowboy("Billy", Point(2.5, -4)));
+            team->add(new OldNinja("Sensei", Point(-7, 3.125)));
+            Character *fallen = new Cowboy("Fallen", Point(0, 9));
+            team->add(fallen);
+            team->add(new Cowboy("Annie", Point(12, 12)));
+            fallen->hit(110);
+
+            FlushCounter counter;
+            std::ostream out(&counter);
+            team->print(out);
+            CHECK_EQ(counter.str(), expected(*team, type == TeamType::Team));
+            CHECK_EQ(counter.flushes, 1);
+
+            std::string buffer;
+            team->print(buffer);
+            CHECK_EQ(buffer, counter.str());
+        }
+    }
+}
+
+TEST_SUITE("Target heap") {
+
+    // The slot a full scan picks: fewest hit points, cowboys first, then the first slot
+    std::size_t weakest(const Team &team) {
+        std::size_t best = TargetHeap::npos;
+        for (std::size_t slot = 0; slot < team.getFighters().size(); slot++) {
+            const Character *fighter = team.getFighters()[slot];
+            if (!fighter->isAlive()) {
+                continue;
+            }
+            if (best == TargetHeap::npos) {
+                best = slot;
+                continue;
+            }
+            const Character *current = team.getFighters()[best];
+            auto rank = [](const Character *character) {
+                return std::make_pair(character->getHitPoints(), character->getKind() == FighterKind::Ninja);
+            };
+            if (rank(fighter) < rank(current)) {
+                best = slot;
+            }
+        }
+        return best;
+    }
+
+    TEST_CASE("The heap follows hits, deaths, revivals and restores of the watched team") {
+        RosterGenerator generator(18);
+        Scenario scenario = generator.scenario(TeamType::Team, TeamType::Team, 300);
+        std::unique_ptr<Team> team = createTeam(TeamType::Team, createFighter(scenario.teamA.roster[0]),
+                                                Team::UNLIMITED);
+        for (std::size_t i = 1; i < scenario.teamA.roster.size(); i++) {
+            team->add(createFighter(scenario.teamA.roster[i]));
+        }
+        std::unique_ptr<Team> other = createTeam(TeamType::Team, createFighter(scenario.teamB.roster[0]));
+        TargetHeap heap;
+        heap.watch(team.get());
+        CHECK_EQ(heap.size(), 300);
+        CHECK_EQ(heap.topSlot(), weakest(*team));
+        BattleSnapshot snapshot(*team, *other);
+
+        Xoshiro256 random(18);
+        for (int step = 0; step < 2000; step++) {
+            Character *fighter = team->getFighters()[random.below(300)];
+            if (step % 7 == 0) {
+                fighter->setHitPoints(static_cast<int>(random.below(151)));
+            } else {
+                fighter->hit(static_cast<int>(random.below(40)));
+            }
+            REQUIRE_EQ(heap.size(), team->stillAlive());
+            REQUIRE_EQ(heap.topSlot(), weakest(*team));
+        }
+
+        snapshot.restore(*team, *other);
+        CHECK_EQ(heap.size(), 300);
+        CHECK_EQ(heap.topSlot(), weakest(*team));
+        auto *newcomer = new Cowboy("Newcomer", Point(0, 0));
+        newcomer->hit(99);
+        team->add(newcomer);
+        CHECK_EQ(heap.top(), newcomer);
+
+        for (Character *member: team->getFighters()) {
+            member->hit(150);
+        }
+        CHECK(heap.empty());
+        CHECK_EQ(heap.top(), nullptr);
+        team.reset();
+        CHECK_EQ(heap.getWatched(), nullptr);
+    }
+
+    TEST_CASE("A smart team shoots the weakest enemy first") {
+        auto *wounded = new Cowboy("Wounded", Point(50, 50));
+        auto *healthy = new YoungNinja("Healthy", Point(1, 1));
+        Team enemy{healthy};
+        enemy.add(wounded);
+        wounded->hit(105);
+
+        SmartTeam smart{new Cowboy("Shooter", Point(0, 0))};
+        smart.add(new OldNinja("Walker", Point(0, 10)));
+        smart.attack(&enemy);
+        CHECK_FALSE(wounded->isAlive());
+        // The ninja went after the next weakest enemy
+        CHECK_EQ(healthy->getHitPoints(), 100);
+        CHECK(smart.getFighters()[1]->getLocation().distance(healthy->getLocation()) <
+              Point(0, 10).distance(Point(1, 1)));
+
+        smart.attack(&enemy);
+        CHECK_EQ(healthy->getHitPoints(), 90);
+
+        CHECK_EQ(smart.askEnemyHitPoints(healthy), 90);
+        CHECK_EQ(smart.askEnemyLocation(healthy).getX(), healthy->getLocation().getX());
+        CHECK_THROWS_AS(smart.askEnemyHitPoints(nullptr), std::invalid_argument);
+        CHECK_THROWS_AS(smart.askEnemyLocation(nullptr), std::invalid_argument);
+    }
+}
+
+TEST_SUITE("Strategy teams") {
+
+    template<class Strategy>
+    std::unique_ptr<Team> build_strategy_team(const TeamSpec &spec) {
+        auto team = std::make_unique<Strategy>(createFighter(spec.roster[0]), Team::UNLIMITED);
+        for (std::size_t i = 1; i < spec.roster.size(); i++) {
+            team->add(createFighter(spec.roster[i]));
+        }
+        return team;
+    }
+
+    // The hit points and locations of every fighter after every attack, until the battle ends
+    std::vector<double> battle_trace(Team &teamA, Team &teamB) {
+        std::vector<double> trace;
+        for (int round = 0; round < 150 && teamA.stillAlive() > 0 && teamB.stillAlive() > 0; round++) {
+            teamA.attack(&teamB);
+            if (teamB.stillAlive() > 0) {
+                teamB.attack(&teamA);
+            }
+            for (const Team *team: {&teamA, &teamB}) {
+                for (const Character *fighter: team->getFighters()) {
+                    trace.push_back(fighter->getHitPoints());
+                    trace.push_back(fighter->getLocation().getX());
+                    trace.push_back(fighter->getLocation().getY());
+                }
+            }
+        }
+        return trace;
+    }
+
+    TEST_CASE("The cowboys first nearest strategy fights exactly like Team") {
+        RosterGenerator generator(19);
+        for (std::size_t size: std::initializer_list<std::size_t>{5, 40, 120}) {
+            Scenario scenario = generator.scenario(TeamType::Team, TeamType::Team2, size);
+            std::unique_ptr<Team> teamA = build_strategy_team<Team>(scenario.teamA);
+            std::unique_ptr<Team> teamB = build_strategy_team<Team2>(scenario.teamB);
+            std::unique_ptr<Team> strategyA = build_strategy_team<NearestTeam>(scenario.teamA);
+            std::unique_ptr<Team> strategyB = build_strategy_team<Team2>(scenario.teamB);
+            CHECK_EQ(battle_trace(*strategyA, *strategyB), battle_trace(*teamA, *teamB));
+        }
+    }
+
+    TEST_CASE("New strategies combine the policies") {
+        using PriorityCowboysFirst = StrategyTeam<PriorityTargeting, CowboysFirst>;
+        auto *walker = new OldNinja("Walker", Point(0, 10));
+        PriorityCowboysFirst team{walker};
+        team.add(new Cowboy("Shooter", Point(0, 0)));
+        auto *wounded = new Cowboy("Wounded", Point(1, 11));
+        Team enemy{new YoungNinja("Healthy", Point(30, 30))};
+        enemy.add(wounded);
+        wounded->hit(100);
+        team.attack(&enemy);
+        // The cowboy acted before the ninja: the wounded enemy was shot dead, the ninja went for the other one
+        CHECK_FALSE(wounded->isAlive());
+        CHECK(walker->getLocation().distance(Point(30, 30)) < Point(0, 10).distance(Point(30, 30)));
+
+        std::ostringstream out;
+        team.print(out);
+        CHECK(out.str().find("name: Shooter") < out.str().find("name: Walker"));
+    }
+
+    TEST_CASE("A killed enemy leader is replaced from the enemy roster") {
+        for (TeamType type: {TeamType::Team, TeamType::Team2, TeamType::SmartTeam}) {
+            std::unique_ptr<Team> team = createTeam(type, new Cowboy("Shooter", Point(0, 0)));
+            auto *leader = new YoungNinja("Leader", Point(1, 1));
+            auto *follower = new OldNinja("Follower", Point(40, 40));
+            Team enemy{leader};
+            enemy.add(follower);
+            leader->hit(95);
+            team->attack(&enemy);
+            CHECK_FALSE(leader->isAlive());
+            CHECK_EQ(enemy.getLeader(), follower);
+        }
+    }
+}
+
+TEST_SUITE("Compile-time stats") {
+    // A fixed formation laid out by the compiler
+    constexpr std::array<Point, 3> FORMATION{Point(0, 0), Point(0.5, 0.5), Point(3, 4)};
+
+    static_assert(FORMATION[0].distanceSquared(FORMATION[2]) == 25);
+    static_assert(FORMATION[0].withinRadius(FORMATION[1], Ninja::SLASH_RANGE));
+    static_assert(!FORMATION[0].withinRadius(FORMATION[2], 5));
+    static_assert(FORMATION[0].closerThan(FORMATION[1], FORMATION[2]));
+    static_assert(statsOf(UnitType::OldNinja).hitPoints == maxHitPoints());
+
+    TEST_CASE("The unit classes take their stats from the table") {
+        const Point origin(0, 0);
+        CHECK_EQ(Cowboy("C", origin).getHitPoints(), statsOf(UnitType::Cowboy).hitPoints);
+        CHECK_EQ(Cowboy("C", origin).getBullets(), statsOf(UnitType::Cowboy).magazine);
+        YoungNinja young("Y", origin);
+        TrainedNinja trained("T", origin);
+        OldNinja old("O", origin);
+        for (const Ninja *ninja: {static_cast<const Ninja *>(&young), static_cast<const Ninja *>(&trained),
+                                  static_cast<const Ninja *>(&old)}) {
+            const UnitStats &stats = ninja == &young ? YOUNG_NINJA_STATS
+                                                     : ninja == &trained ? TRAINED_NINJA_STATS : OLD_NINJA_STATS;
+            CHECK_EQ(ninja->getSpeed(), stats.speed);
+            CHECK_EQ(ninja->getHitPoints(), stats.hitPoints);
+        }
+
+        Cowboy shooter("Shooter", origin);
+        Cowboy target("Target", Point(1, 1));
+        shooter.shoot(&target);
+        CHECK_EQ(target.getHitPoints(), COWBOY_STATS.hitPoints - COWBOY_STATS.damage);
+        young.slash(&target);
+        CHECK_EQ(target.getHitPoints(), COWBOY_STATS.hitPoints - COWBOY_STATS.damage);
+        Point reach = Point::moveTowards(origin, target.getLocation(), YOUNG_NINJA_STATS.slashRange / 2);
+        CHECK(reach.withinRadius(origin, YOUNG_NINJA_STATS.slashRange));
+    }
+
+    TEST_CASE("Constant points keep the runtime checks") {
+        Point point(1, 2);
+        point.setX(3);
+        CHECK_EQ(point.getX(), 3);
+        CHECK_THROWS_AS(point.setY(std::numeric_limits<double>::infinity()), std::out_of_range);
+        CHECK_THROWS_AS(Point(std::numeric_limits<double>::infinity(), 0), std::out_of_range);
+    }
+}
+
+TEST_SUITE("Free-for-all") {
+    std::unique_ptr<Team> ffa_team(const TeamSpec &spec) {
+        std::unique_ptr<Team> team = std::make_unique<Team>(createFighter(spec.roster[0]), Team::UNLIMITED);
+        for (std::size_t i = 1; i < spec.roster.size(); i++) {
+            team->add(createFighter(spec.roster[i]));
+        }
+        return team;
+    }
+
+    std::vector<int> hit_points(const std::vector<std::unique_ptr<Team>> &teams) {
+        std::vector<int> all;
+        for (const std::unique_ptr<Team> &team: teams) {
+            for (const Character *fighter: team->getFighters()) {
+                all.push_back(fighter->getHitPoints());
+            }
+        }
+        return all;
+    }
+
+    TEST_CASE("The nearest enemy is searched in every other team") {
+        Team first{new Cowboy("Own", Point(0, 0))};
+        first.add(new Cowboy("Mate", Point(1, 0)));
+        Team second{new Cowboy("Far", Point(9, 0))};
+        Team third{new YoungNinja("Near", Point(0, 4))};
+        FreeForAll battle;
+        CHECK_EQ(battle.join(&first), 0);
+        CHECK_EQ(battle.join(&second), 1);
+        CHECK_EQ(battle.join(&third), 2);
+        CHECK_THROWS_AS(battle.join(&second), std::invalid_argument);
+        CHECK_THROWS_AS(battle.join(nullptr), std::invalid_argument);
+
+        CHECK_EQ(battle.nearestEnemy(0, Point(0, 0))->getName(), "Near");
+        CHECK_EQ(battle.nearestEnemy(2, Point(0, 4))->getName(), "Own");
+        CHECK_EQ(battle.nearestEnemy(1, Point(9, 0))->getName(), "Mate");
+        third.getLeader()->hit(100);
+        CHECK_EQ(battle.nearestEnemy(0, Point(0, 0))->getName(), "Far");
+        // A fighter joining a team after the battle started is searched too
+        third.add(new OldNinja("Late", Point(0, 2)));
+        CHECK_EQ(battle.nearestEnemy(0, Point(0, 0))->getName(), "Late");
+        CHECK_EQ(battle.standing(), 3);
+        CHECK_THROWS_AS(battle.nearestEnemy(3, Point(0, 0)), std::out_of_range);
+    }
+
+    TEST_CASE("Two teams fight as with Team::attack, taking turns to open the rounds") {
+        for (std::uint64_t seed = 0; seed < 20; seed++) {
+            Scenario scenario = RosterGenerator(seed).scenario(TeamType::Team, TeamType::Team, 12);
+            std::vector<std::unique_ptr<Team>> ffa;
+            std::vector<std::unique_ptr<Team>> duel;
+            for (std::vector<std::unique_ptr<Team>> *teams: {&ffa, &duel}) {
+                teams->push_back(ffa_team(scenario.teamA));
+                teams->push_back(ffa_team(scenario.teamB));
+            }
+            FreeForAll battle;
+            battle.join(ffa[0].get());
+            battle.join(ffa[1].get());
+            for (int round = 0; round < 100 && duel[0]->stillAlive() > 0 && duel[1]->stillAlive() > 0; round++) {
+                Team *opening = duel[static_cast<std::size_t>(round % 2)].get();
+                Team *closing = duel[static_cast<std::size_t>(1 - round % 2)].get();
+                opening->attack(closing);
+                if (closing->stillAlive() > 0) {
+                    closing->attack(opening);
+                }
+                battle.round();
+                CHECK_EQ(hit_points(ffa), hit_points(duel));
+            }
+        }
+    }
+
+    TEST_CASE("A crowded battle ends with one team standing") {
+        const std::size_t teamCount = 40;
+        std::vector<std::unique_ptr<Team>> teams;
+        FreeForAll battle;
+        for (std::size_t index = 0; index < teamCount; index++) {
+            RosterGenerator generator(99, index, -300, 300);
+            teams.push_back(ffa_team(generator.team(TeamType::Team, 25)));
+            battle.join(teams.back().get());
+        }
+
+        Xoshiro256 random(21);
+        while (battle.standing() > 1 && battle.getRounds() < 2000) {
+            battle.round();
+            // The shared grid answers like scanning every other roster
+            std::size_t index = static_cast<std::size_t>(random() % teamCount);
+            Point probe(static_cast<double>(random() % 600) - 300, static_cast<double>(random() % 600) - 300);
+            const Character *expected = nullptr;
+            for (std::size_t other = 0; other < teamCount; other++) {
+                const Character *closest = other == index ? nullptr : teams[other]->closestAlive(probe);
+                if (closest && (!expected || probe.distanceSquared(closest->getLocation()) <
+                                             probe.distanceSquared(expected->getLocation()))) {
+                    expected = closest;
+                }
+            }
+            CHECK_EQ(battle.nearestEnemy(index, probe), expected);
+        }
+        std::size_t winner = battle.run(2000);
+        REQUIRE_NE(winner, FreeForAll::npos);
+        for (std::size_t index = 0; index < teamCount; index++) {
+            CHECK_EQ(teams[index]->stillAlive() > 0, index == winner);
+        }
+
+        // A team destroyed during the battle is out of it
+        teams[winner].reset();
+        CHECK_EQ(battle.getTeam(winner), nullptr);
+        CHECK_EQ(battle.standing(), 0);
+        CHECK_EQ(battle.nearestEnemy(0, Point(0, 0)), nullptr);
+    }
+}
+
+TEST_SUITE("Tournament") {
+    TEST_CASE("Every battle plays like BattleRunner::runBattle with its seed") {
+        Tournament tournament(3);
+        std::vector<std::vector<FighterSpec>> rosters;
+        for (std::uint64_t roster = 0; roster < 3; roster++) {
+            rosters.push_back(RosterGenerator(40 + roster, 0, -20, 20).team(TeamType::Team, 6 + roster).roster);
+            CHECK_EQ(tournament.addRoster(rosters.back()), roster);
+        }
+        TournamentRules rules;
+        rules.jitter = 3.0;
+        rules.maxRounds = 150;
+        const std::size_t battles = 3;
+        const std::uint64_t seed = 7;
+        TournamentReport report = tournament.run(rules, battles, seed);
+        const std::size_t count = report.entrants.size();
+        REQUIRE_EQ(count, 9);
+        CHECK_EQ(report.pairings(), 27);
+        CHECK_EQ(report.battles(), 81);
+
+        for (std::size_t first = 0; first < count; first++) {
+            for (std::size_t second = first + 1; second < count; second++) {
+                if (!report.played(first, second)) {
+                    CHECK_EQ(report.winsOf(first, second) + report.winsOf(second, first), 0);
+                    continue;
+                }
+                TeamSpec specFirst{report.entrants[first].strategy, rosters[report.entrants[first].roster]};
+                TeamSpec specSecond{report.entrants[second].strategy, rosters[report.entrants[second].roster]};
+                std::uint32_t winsFirst = 0;
+                std::uint32_t winsSecond = 0;
+                for (std::size_t battle = 0; battle < battles; battle++) {
+                    bool swapped = battle % 2 == 1;
+                    Scenario scenario{swapped ? specSecond : specFirst, swapped ? specFirst : specSecond, rules.jitter,
+                                      rules.maxRounds};
+                    BattleOutcome outcome = BattleRunner::runBattle(
+                            scenario, BattleRunner::battleSeed(seed, (first * count + second) * battles + battle));
+                    if (outcome.result != BattleResult::Draw) {
+                        ((outcome.result == BattleResult::TeamAWins) != swapped ? winsFirst : winsSecond)++;
+                    }
+                }
+                CHECK_EQ(report.winsOf(first, second), winsFirst);
+                CHECK_EQ(report.winsOf(second, first), winsSecond);
+                CHECK_EQ(report.drawsOf(first, second), battles - winsFirst - winsSecond);
+            }
+        }
+
+        // The report depends on nothing but the rosters, the rules and the seed
+        Tournament single(1);
+        for (const std::vector<FighterSpec> &roster: rosters) {
+            single.addRoster(roster);
+        }
+        TournamentReport again = single.run(rules, battles, seed);
+        CHECK_EQ(again.wins, report.wins);
+        CHECK_EQ(again.ratings, report.ratings);
+    }
+
+    TEST_CASE("The ratings rank the strongest roster first") {
+        Tournament tournament(2);
+        std::vector<FighterSpec> army;
+        for (int i = 0; i < 8; i++) {
+            army.push_back(FighterSpec{UnitType::OldNinja, "Elder", static_cast<double>(i), 0});
+        }
+        tournament.addRoster(army);
+        tournament.addRoster({FighterSpec{UnitType::YoungNinja, "Kid", 10, 0}});
+        tournament.addRoster({FighterSpec{UnitType::Cowboy, "Lone", -10, 0},
+                              FighterSpec{UnitType::Cowboy, "Ranger", -11, 0}});
+        TournamentRules rules;
+        rules.strategies = {TeamType::Team, TeamType::SmartTeam};
+        TournamentReport report = tournament.run(rules, 2, 3);
+        REQUIRE_EQ(report.entrants.size(), 6);
+        std::vector<std::size_t> ranking = report.ranking();
+        CHECK_EQ(report.entrants[ranking[0]].roster, 0);
+        CHECK_EQ(report.entrants[ranking[1]].roster, 0);
+        CHECK(report.ratings[ranking[0]] > Tournament::INITIAL_RATING);
+        CHECK(report.ratings[ranking.back()] < Tournament::INITIAL_RATING);
+        CHECK_EQ(report.winsOf(0, 2), 2);
+
+        CHECK_THROWS_AS(tournament.addRoster({}), std::invalid_argument);
+        rules.strategies.clear();
+        CHECK_THROWS_AS(tournament.run(rules, 1, 0), std::invalid_argument);
+    }
+}
+
+namespace {
+    // The closest living point by a linear scan, the smallest slot of equidistant ones.
+    std::size_t scanNearest(const FighterStore &store, double x, double y) {
+        std::size_t closest = StaticGrid::npos;
+        double best = 0;
+        for (std::size_t slot = 0; slot < store.size(); slot++) {
+            double dx = store.x[slot] - x;
+            double dy = store.y[slot] - y;
+            if (store.isAlive(slot) && (closest == StaticGrid::npos || dx * dx + dy * dy < best)) {
+                closest = slot;
+                best = dx * dx + dy * dy;
+            }
+        }
+        return closest;
+    }
+
+    // The turn of a side of a sharded battle, played one fighter after the other.
+    std::vector<std::size_t> referenceTurn(FighterStore &attackers, FighterStore &victims) {
+        std::vector<int> damage(victims.size(), 0);
+        for (std::size_t slot = 0; slot < attackers.size(); slot++) {
+            std::size_t victim = scanNearest(victims, attackers.x[slot], attackers.y[slot]);
+            if (!attackers.isAlive(slot) || victim == StaticGrid::npos) {
+                continue;
+            }
+            if (attackers.kind[slot] == FighterKind::Cowboy) {
+                if (attackers.bullets[slot] > 0) {
+                    attackers.bullets[slot]--;
+                    damage[victim] += Cowboy::SHOT_DAMAGE;
+                } else {
+                    attackers.bullets[slot] = Cowboy::MAGAZINE_SIZE;
+                }
+                continue;
+            }
+            Point from(attackers.x[slot], attackers.y[slot]);
+            Point target(victims.x[victim], victims.y[victim]);
+            if (from.withinRadius(target, Ninja::SLASH_RANGE)) {
+                damage[victim] += Ninja::SLASH_DAMAGE;
+            } else {
+                double dx = target.getX() - from.getX();
+                double dy = target.getY() - from.getY();
+                double distance = std::sqrt(dx * dx + dy * dy);
+                auto speed = static_cast<double>(attackers.speed[slot]);
+                attackers.x[slot] = distance <= speed ? target.getX() : from.getX() + speed * dx / distance;
+                attackers.y[slot] = distance <= speed ? target.getY() : from.getY() + speed * dy / distance;
+            }
+        }
+        std::vector<std::size_t> died;
+        for (std::size_t victim = 0; victim < victims.size(); victim++) {
+            if (victims.isAlive(victim) && damage[victim] > 0) {
+                victims.hitPoints[victim] = std::max(0, victims.hitPoints[victim] - damage[victim]);
+                if (victims.hitPoints[victim] == 0) {
+                    died.push_back(victim);
+                }
+            }
+        }
+        return died;
+    }
+
+    void checkSameStore(const FighterStore &first, const FighterStore &second) {
+        CHECK_EQ(first.x, second.x);
+        CHECK_EQ(first.y, second.y);
+        CHECK_EQ(first.hitPoints, second.hitPoints);
+        CHECK_EQ(first.bullets, second.bullets);
+    }
+}
+
+TEST_SUITE("Sharded battle") {
+    TEST_CASE("The static grid finds the closest living point like a linear scan") {
+        Xoshiro256 generator(5);
+        FighterStore store;
+        for (int i = 0; i < 500; i++) {
+            // Integer coordinates, so that many points are equidistant from the queries
+            store.x.push_back(std::floor(generator.uniform(-30, 30)));
+            store.y.push_back(std::floor(generator.uniform(-10, 10)));
+            store.hitPoints.push_back(i % 3 == 0 ? 0 : 10);
+        }
+        StaticGrid grid;
+        CHECK_EQ(grid.size(), 0);
+        CHECK_EQ(grid.nearest(0, 0), StaticGrid::npos);
+        grid.build(store.x.data(), store.y.data(), store.hitPoints.data(), 500);
+        CHECK_EQ(grid.size(), store.countAlive());
+        for (int query = 0; query < 300; query++) {
+            double x = std::floor(generator.uniform(-60, 60));
+            double y = std::floor(generator.uniform(-40, 40));
+            CHECK_EQ(grid.nearest(x, y), scanNearest(store, x, y));
+        }
+
+        // A single point, and a rebuild over nobody
+        std::fill(store.hitPoints.begin(), store.hitPoints.end(), 0);
+        store.hitPoints[42] = 1;
+        grid.build(store.x.data(), store.y.data(), store.hitPoints.data(), 500);
+        CHECK_EQ(grid.nearest(1000, -1000), 42);
+        store.hitPoints[42] = 0;
+        grid.build(store.x.data(), store.y.data(), store.hitPoints.data(), 500);
+        CHECK_EQ(grid.nearest(0, 0), StaticGrid::npos);
+    }
+
+    TEST_CASE("Every turn plays like the fighters acting one after the other") {
+        Scenario scenario = RosterGenerator(11, 0, -40, 40).scenario(TeamType::Team, TeamType::Team, 300);
+        scenario.jitter = 2.0;
+        ShardedBattle battle(3);
+        battle.load(scenario, 9);
+        FighterStore sideA = battle.getSide(0);
+        FighterStore sideB = battle.getSide(1);
+        for (int round = 0; round < 40 && battle.stillAlive(0) > 0 && battle.stillAlive(1) > 0; round++) {
+            for (std::size_t side = 0; side < 2; side++) {
+                battle.turn(side);
+                std::vector<std::size_t> died = side == 0 ? referenceTurn(sideA, sideB) : referenceTurn(sideB, sideA);
+                CHECK_EQ(battle.getKills(1 - side), died);
+                checkSameStore(battle.getSide(0), sideA);
+                checkSameStore(battle.getSide(1), sideB);
+            }
+        }
+        CHECK_EQ(battle.stillAlive(0), sideA.countAlive());
+        CHECK_EQ(battle.stillAlive(1), sideB.countAlive());
+        CHECK_THROWS_AS(battle.turn(2), std::out_of_range);
+        CHECK_THROWS_AS(battle.getSide(2), std::out_of_range);
+        CHECK_THROWS_AS(battle.getKills(2), std::out_of_range);
+    }
+
+    TEST_CASE("A battle plays the same with any number of threads and the same seed") {
+        Scenario scenario = RosterGenerator(3, 0, -60, 60).scenario(TeamType::Team, TeamType::SmartTeam, 2000);
+        scenario.jitter = 1.5;
+        ShardedBattle single(1);
+        single.load(scenario, 21);
+        BattleOutcome expected = single.play(500);
+        CHECK_NE(expected.result, BattleResult::Draw);
+        for (std::size_t threads: {2UL, 4UL, 7UL}) {
+            ShardedBattle battle(threads);
+            battle.load(scenario, 21);
+            BattleOutcome outcome = battle.play(500);
+            CHECK_EQ(outcome.result, expected.result);
+            CHECK_EQ(outcome.rounds, expected.rounds);
+            CHECK_EQ(outcome.survivingHitPointsA, expected.survivingHitPointsA);
+            CHECK_EQ(outcome.survivingHitPointsB, expected.survivingHitPointsB);
+            checkSameStore(battle.getSide(0), single.getSide(0));
+            checkSameStore(battle.getSide(1), single.getSide(1));
+        }
+        single.load(scenario, 21);
+        std::vector<double> start = single.getSide(0).x;
+        single.load(scenario, 22);
+        CHECK_NE(single.getSide(0).x, start);
+    }
+
+    TEST_CASE("Loading and publishing teams") {
+        Scenario scenario = RosterGenerator(8, 0, -5, 5).scenario(TeamType::Team, TeamType::Team2, 12);
+        ShardedBattle fromScenario(2);
+        fromScenario.load(scenario, 4);
+        for (std::size_t slot = 0; slot < 12; slot++) {
+            const UnitStats &stats = statsOf(scenario.teamA.roster[slot].type);
+            CHECK_EQ(fromScenario.getSide(0).hitPoints[slot], stats.hitPoints);
+            CHECK_EQ(fromScenario.getSide(0).speed[slot], stats.speed);
+            CHECK_EQ(fromScenario.getSide(0).x[slot], scenario.teamA.roster[slot].x);
+        }
+
+        auto build = [&](const TeamSpec &spec) {
+            std::unique_ptr<Team> team = createTeam(spec.type, createFighter(spec.roster.front()), Team::UNLIMITED);
+            for (std::size_t slot = 1; slot < spec.roster.size(); slot++) {
+                team->add(createFighter(spec.roster[slot]));
+            }
+            return team;
+        };
+        std::unique_ptr<Team> teamA = build(scenario.teamA);
+        std::unique_ptr<Team> teamB = build(scenario.teamB);
+        ShardedBattle fromTeams(2);
+        BattleOutcome outcome = fromTeams.run(*teamA, *teamB, 1000);
+        BattleOutcome expected = fromScenario.play(1000);
+        CHECK_EQ(outcome.result, expected.result);
+        CHECK_EQ(outcome.rounds, expected.rounds);
+        CHECK_EQ(static_cast<std::size_t>(teamA->stillAlive()), fromTeams.stillAlive(0));
+        CHECK_EQ(static_cast<std::size_t>(teamB->stillAlive()), fromTeams.stillAlive(1));
+        CHECK_EQ(teamA->getFighters()[3]->getLocation().getX(), fromScenario.getSide(0).x[3]);
+        CHECK_EQ(fromTeams.getRounds(), outcome.rounds);
+
+        std::unique_ptr<Team> smaller = build(RosterGenerator(1).team(TeamType::Team, 3));
+        CHECK_THROWS_AS(fromTeams.publish(*smaller, *teamB), std::invalid_argument);
+        scenario.teamB.roster.clear();
+        CHECK_THROWS_AS(fromScenario.load(scenario, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Atomic damage plays like the tile buffers, killing every victim once") {
+        Scenario scenario = RosterGenerator(17, 0, -30, 30).scenario(TeamType::Team, TeamType::Team, 1500);
+        scenario.jitter = 1.0;
+        ShardedBattle buffered(3);
+        ShardedBattle atomic(4, ShardedBattle::DamageMode::Atomic);
+        CHECK_EQ(buffered.getDamageMode(), ShardedBattle::DamageMode::TileBuffers);
+        CHECK_EQ(atomic.getDamageMode(), ShardedBattle::DamageMode::Atomic);
+        buffered.load(scenario, 5);
+        atomic.load(scenario, 5);
+        std::size_t killed = 0;
+        for (int round = 0; round < 300 && atomic.stillAlive(0) > 0 && atomic.stillAlive(1) > 0; round++) {
+            for (std::size_t side = 0; side < 2; side++) {
+                buffered.turn(side);
+                atomic.turn(side);
+                const std::vector<std::size_t> &kills = atomic.getKills(1 - side);
+                CHECK_EQ(kills, buffered.getKills(1 - side));
+                CHECK(std::adjacent_find(kills.begin(), kills.end()) == kills.end());
+                killed += kills.size();
+            }
+        }
+        checkSameStore(atomic.getSide(0), buffered.getSide(0));
+        checkSameStore(atomic.getSide(1), buffered.getSide(1));
+        CHECK(*std::min_element(atomic.getSide(1).hitPoints.begin(), atomic.getSide(1).hitPoints.end()) >= 0);
+        CHECK_EQ(killed, 3000 - atomic.stillAlive(0) - atomic.stillAlive(1));
+        CHECK_EQ(atomic.stillAlive(0), atomic.getSide(0).countAlive());
+        CHECK_EQ(atomic.stillAlive(1), atomic.getSide(1).countAlive());
+
+        // The mode may change between turns
+        buffered.load(scenario, 6);
+        atomic.load(scenario, 6);
+        atomic.setDamageMode(ShardedBattle::DamageMode::TileBuffers);
+        atomic.turn(0);
+        buffered.turn(0);
+        atomic.setDamageMode(ShardedBattle::DamageMode::Atomic);
+        atomic.turn(1);
+        buffered.turn(1);
+        BattleOutcome expected = buffered.play(400);
+        BattleOutcome outcome = atomic.play(400);
+        CHECK_EQ(outcome.result, expected.result);
+        CHECK_EQ(outcome.survivingHitPointsA, expected.survivingHitPointsA);
+        CHECK_EQ(outcome.survivingHitPointsB, expected.survivingHitPointsB);
+    }
+
+    TEST_CASE("Simultaneous rounds play both sides on the state the round started in") {
+        Scenario scenario = RosterGenerator(23, 0, -25, 25).scenario(TeamType::Team, TeamType::Team, 400);
+        scenario.jitter = 2.0;
+        ShardedBattle battle(3, ShardedBattle::DamageMode::TileBuffers, ShardedBattle::Resolution::Simultaneous);
+        CHECK_EQ(battle.getResolution(), ShardedBattle::Resolution::Simultaneous);
+        battle.load(scenario, 2);
+        FighterStore sideA = battle.getSide(0);
+        FighterStore sideB = battle.getSide(1);
+        for (int round = 0; round < 60 && battle.stillAlive(0) > 0 && battle.stillAlive(1) > 0; round++) {
+            battle.round();
+            // Each side acts on a copy of the round start, and takes the damage the other side dealt to the start
+            FighterStore hitA = sideA;
+            FighterStore hitB = sideB;
+            std::vector<std::size_t> diedB = referenceTurn(sideA, hitB);
+            std::vector<std::size_t> diedA = referenceTurn(sideB, hitA);
+            sideA.hitPoints = hitA.hitPoints;
+            sideB.hitPoints = hitB.hitPoints;
+            CHECK_EQ(battle.getKills(0), diedA);
+            CHECK_EQ(battle.getKills(1), diedB);
+            checkSameStore(battle.getSide(0), sideA);
+            checkSameStore(battle.getSide(1), sideB);
+            CHECK_EQ(battle.getRounds(), round + 1);
+        }
+        CHECK_EQ(battle.stillAlive(0), sideA.countAlive());
+        CHECK_EQ(battle.stillAlive(1), sideB.countAlive());
+
+        // Same with atomic damage and another number of threads
+        ShardedBattle atomic(2, ShardedBattle::DamageMode::Atomic, ShardedBattle::Resolution::Simultaneous);
+        atomic.load(scenario, 2);
+        battle.load(scenario, 2);
+        BattleOutcome expected = battle.play(500);
+        BattleOutcome outcome = atomic.play(500);
+        CHECK_EQ(outcome.result, expected.result);
+        CHECK_EQ(outcome.rounds, expected.rounds);
+        checkSameStore(atomic.getSide(0), battle.getSide(0));
+        checkSameStore(atomic.getSide(1), battle.getSide(1));
+    }
+
+    TEST_CASE("Two gunslingers shooting at once fall together") {
+        Scenario scenario{TeamSpec{TeamType::Team, {FighterSpec{UnitType::Cowboy, "Left", 0, 0}}},
+                          TeamSpec{TeamType::Team, {FighterSpec{UnitType::Cowboy, "Right", 5, 0}}}};
+        ShardedBattle battle(1);
+        battle.load(scenario, 0);
+        BattleOutcome alternating = battle.play(100);
+        CHECK_EQ(alternating.result, BattleResult::TeamAWins);
+        CHECK_EQ(alternating.survivingHitPointsA, 10);
+
+        battle.setResolution(ShardedBattle::Resolution::Simultaneous);
+        battle.load(scenario, 0);
+        BattleOutcome simultaneous = battle.play(100);
+        CHECK_EQ(simultaneous.result, BattleResult::Draw);
+        CHECK_EQ(simultaneous.rounds, alternating.rounds);
+        CHECK_EQ(battle.stillAlive(0), 0);
+        CHECK_EQ(battle.stillAlive(1), 0);
+        CHECK_EQ(battle.getKills(0), std::vector<std::size_t>{0});
+        CHECK_EQ(battle.getKills(1), std::vector<std::size_t>{0});
+    }
+}
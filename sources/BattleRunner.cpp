@@ -0,0 +1,211 @@
+/**
+ * @file BattleRunner.cpp
+ * @brief Implementation of the BattleRunner class and the statistics it reports.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "BattleRunner.hpp"
+#include <algorithm>
+#include <numeric>
+#include "Xoshiro256.hpp"
+
+namespace ariel {
+
+/**
+ * @brief Summarizes a set of samples.
+ * @param samples The observed values, one per battle.
+ * @return The minimum, maximum, mean, median, 90th percentile and histogram of the samples.
+ */
+    Distribution Distribution::of(std::vector<int> samples) {
+        Distribution distribution;
+        if (samples.empty()) {
+            return distribution;
+        }
+        std::sort(samples.begin(), samples.end());
+        distribution.min = samples.front();
+        distribution.max = samples.back();
+        double sum = std::accumulate(samples.begin(), samples.end(), 0.0);
+        distribution.mean = sum / static_cast<double>(samples.size());
+        distribution.median = samples[samples.size() / 2];
+        distribution.percentile90 = samples[samples.size() * 9 / 10];
+        for (int sample: samples) {
+            distribution.histogram[sample]++;
+        }
+        return distribution;
+    }
+
+/**
+ * @brief The fraction of the battles won by team A.
+ * @return A value in [0, 1], 0 if no battle was played.
+ */
+    double BattleReport::winRateA() const {
+        return battles == 0 ? 0.0 : static_cast<double>(winsA) / static_cast<double>(battles);
+    }
+
+/**
+ * @brief The fraction of the battles won by team B.
+ * @return A value in [0, 1], 0 if no battle was played.
+ */
+    double BattleReport::winRateB() const {
+        return battles == 0 ? 0.0 : static_cast<double>(winsB) / static_cast<double>(battles);
+    }
+
+/**
+ * @brief Constructs a runner.
+ * @param threadCount The number of worker threads, 0 means one per hardware thread.
+ */
+    BattleRunner::BattleRunner(std::size_t threadCount) : pool(threadCount) {
+        for (std::size_t worker = 0; worker < this->pool.size(); worker++) {
+            this->arenas.push_back(std::make_unique<FighterArena>());
+        }
+    }
+
+/**
+ * @brief Derives the seed of a single battle from the seed of the whole run (splitmix64 finalizer).
+ * @param seed The seed of the run.
+ * @param battle The index of the battle inside the run.
+ * @return The seed of the battle.
+ */
+    std::uint64_t BattleRunner::battleSeed(std::uint64_t seed, std::size_t battle) {
+        return Xoshiro256::streamSeed(seed, static_cast<std::uint64_t>(battle));
+    }
+
+/**
+ * @brief Plays a whole battle of the scenario with fighters living in an arena of their own.
+ * @param scenario The rosters and team strategies.
+ * @param seed The seed used to displace the fighters by up to scenario.jitter.
+ * @return The winner, the number of rounds played and the hit points left on each side.
+ * @throws std::invalid_argument If one of the rosters is empty.
+ */
+    BattleOutcome BattleRunner::runBattle(const Scenario &scenario, std::uint64_t seed) {
+        FighterArena arena;
+        return runBattle(scenario, seed, arena);
+    }
+
+/**
+ * @brief Plays a whole battle of the scenario: team A attacks, then team B, until one of them is eliminated.
+ * The arena is reset before the fighters are built, so the fighters of the previous battle played in it
+ * are released and their memory reused.
+ * @param scenario The rosters and team strategies.
+ * @param seed The seed used to displace the fighters by up to scenario.jitter.
+ * @param arena The arena the fighters are created in, no team may still hold fighters of it.
+ * @param recorder The log the events of the battle are recorded to, team A as side 0 and team B as side 1,
+ * nullptr to play it unrecorded. Every round starts a new round of the log.
+ * @return The winner, the number of rounds played and the hit points left on each side.
+ * @throws std::invalid_argument If one of the rosters is empty.
+ */
+    BattleOutcome BattleRunner::runBattle(const Scenario &scenario, std::uint64_t seed, FighterArena &arena,
+                                          ReplayRecorder *recorder) {
+        arena.reset();
+        Xoshiro256 generator(seed);
+
+        auto build = [&](const TeamSpec &spec) {
+            if (spec.roster.empty()) {
+                throw std::invalid_argument("Error: A team needs at least a leader.");
+            }
+            std::unique_ptr<Team> team;
+            for (const FighterSpec &fighterSpec: spec.roster) {
+                double offsetX = 0.0;
+                double offsetY = 0.0;
+                if (scenario.jitter > 0) {
+                    offsetX = generator.uniform(-scenario.jitter, scenario.jitter);
+                    offsetY = generator.uniform(-scenario.jitter, scenario.jitter);
+                }
+                Character *fighter = createFighter(fighterSpec, arena, offsetX, offsetY);
+                if (!team) {
+                    team = createTeam(spec.type, fighter, std::max(Team::MAX_FIGHTERS, spec.roster.size()));
+                } else {
+                    team->add(fighter);
+                }
+            }
+            return team;
+        };
+        std::unique_ptr<Team> teamA = build(scenario.teamA);
+        std::unique_ptr<Team> teamB = build(scenario.teamB);
+        teamA->recordTo(recorder, 0);
+        teamB->recordTo(recorder, 1);
+        return fight(*teamA, *teamB, scenario.maxRounds, recorder);
+    }
+
+/**
+ * @brief Plays a battle between two teams that are already built: team A attacks, then team B, until one of them
+ * is eliminated or a number of rounds was played.
+ * @param teamA The team attacking first in every round.
+ * @param teamB The other team.
+ * @param maxRounds The number of rounds after which the battle is a draw.
+ * @param recorder The log whose rounds follow the rounds of the battle, nullptr if the battle is not recorded.
+ * The teams must already be recording to it.
+ * @return The winner, the number of rounds played and the hit points left on each side.
+ */
+    BattleOutcome BattleRunner::fight(Team &teamA, Team &teamB, int maxRounds, ReplayRecorder *recorder) {
+        int rounds = 0;
+        while (rounds < maxRounds && teamA.stillAlive() > 0 && teamB.stillAlive() > 0) {
+            if (recorder) {
+                recorder->nextRound();
+            }
+            teamA.attack(&teamB);
+            if (teamB.stillAlive() > 0) {
+                teamB.attack(&teamA);
+            }
+            rounds++;
+        }
+
+        auto survivingHitPoints = [](const Team &team) {
+            int total = 0;
+            for (const Character *fighter: team.getFighters()) {
+                total += fighter->getHitPoints();
+            }
+            return total;
+        };
+        BattleOutcome outcome{BattleResult::Draw, rounds, survivingHitPoints(teamA), survivingHitPoints(teamB)};
+        if (teamA.stillAlive() > 0 && teamB.stillAlive() == 0) {
+            outcome.result = BattleResult::TeamAWins;
+        } else if (teamB.stillAlive() > 0 && teamA.stillAlive() == 0) {
+            outcome.result = BattleResult::TeamBWins;
+        }
+        return outcome;
+    }
+
+/**
+ * @brief Plays independent battles of the scenario across the worker threads and aggregates their outcomes.
+ * Battle i is seeded with battleSeed(seed, i), so the report only depends on the scenario, the number of battles
+ * and the seed, not on the number of threads.
+ * @param scenario The rosters and team strategies.
+ * @param battles The number of battles to play.
+ * @param seed The seed of the run.
+ * @return The win counts and the distributions of rounds and surviving hit points.
+ */
+    BattleReport BattleRunner::run(const Scenario &scenario, std::size_t battles, std::uint64_t seed) {
+        std::vector<BattleOutcome> outcomes(battles);
+        pool.parallelFor(battles, [&](std::size_t battle, std::size_t worker) {
+            outcomes[battle] = runBattle(scenario, battleSeed(seed, battle), *this->arenas[worker]);
+        });
+
+        BattleReport report;
+        report.battles = battles;
+        std::vector<int> rounds;
+        std::vector<int> survivorsA;
+        std::vector<int> survivorsB;
+        rounds.reserve(battles);
+        survivorsA.reserve(battles);
+        survivorsB.reserve(battles);
+        for (const BattleOutcome &outcome: outcomes) {
+            if (outcome.result == BattleResult::TeamAWins) {
+                report.winsA++;
+            } else if (outcome.result == BattleResult::TeamBWins) {
+                report.winsB++;
+            } else {
+                report.draws++;
+            }
+            rounds.push_back(outcome.rounds);
+            survivorsA.push_back(outcome.survivingHitPointsA);
+            survivorsB.push_back(outcome.survivingHitPointsB);
+        }
+        report.rounds = Distribution::of(std::move(rounds));
+        report.survivingHitPointsA = Distribution::of(std::move(survivorsA));
+        report.survivingHitPointsB = Distribution::of(std::move(survivorsB));
+        return report;
+    }
+
+}
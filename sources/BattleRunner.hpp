@@ -0,0 +1,86 @@
+/**
+ * @file BattleRunner.hpp
+ * @brief Monte Carlo battle runner: plays many independent, seeded battles of one scenario on all cores.
+ * Every battle builds its own teams from the scenario, so battles share nothing but the read-only scenario
+ * and the per-battle outcomes are aggregated in battle order, independently of how the work was scheduled.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_BATTLERUNNER_HPP
+#define COWBOY_VS_NINJA_B_BATTLERUNNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "ReplayRecorder.hpp"
+#include "Scenario.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace ariel {
+
+    enum class BattleResult : std::uint8_t {
+        TeamAWins,
+        TeamBWins,
+        Draw
+    };
+
+    struct BattleOutcome {
+        BattleResult result;
+        int rounds;
+        int survivingHitPointsA;
+        int survivingHitPointsB;
+    };
+
+    struct Distribution {
+        int min = 0;
+        int max = 0;
+        double mean = 0.0;
+        int median = 0;
+        int percentile90 = 0;
+        // Maps every observed value to the number of battles it was observed in.
+        std::map<int, std::size_t> histogram;
+
+        static Distribution of(std::vector<int> samples);
+    };
+
+    struct BattleReport {
+        std::size_t battles = 0;
+        std::size_t winsA = 0;
+        std::size_t winsB = 0;
+        std::size_t draws = 0;
+        Distribution rounds;
+        Distribution survivingHitPointsA;
+        Distribution survivingHitPointsB;
+
+        double winRateA() const;
+
+        double winRateB() const;
+    };
+
+    class BattleRunner {
+    public:
+        explicit BattleRunner(std::size_t threadCount = 0);
+
+        BattleReport run(const Scenario &scenario, std::size_t battles, std::uint64_t seed);
+
+        static BattleOutcome runBattle(const Scenario &scenario, std::uint64_t seed);
+
+        static BattleOutcome runBattle(const Scenario &scenario, std::uint64_t seed, FighterArena &arena,
+                                       ReplayRecorder *recorder = nullptr);
+
+        static BattleOutcome fight(Team &teamA, Team &teamB, int maxRounds, ReplayRecorder *recorder = nullptr);
+
+        static std::uint64_t battleSeed(std::uint64_t seed, std::size_t battle);
+
+    private:
+        WorkStealingPool pool;
+        // One arena per worker, reused by every battle the worker plays.
+        std::vector<std::unique_ptr<FighterArena>> arenas;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_BATTLERUNNER_HPP
@@ -0,0 +1,166 @@
+/**
+ * @file BattleSnapshot.cpp
+ * @brief Implementation of the BattleSnapshot class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "BattleSnapshot.hpp"
+#include <stdexcept>
+#include <type_traits>
+#include "Team.hpp"
+
+namespace ariel {
+
+    static_assert(std::is_trivially_copyable<FighterState>::value, "Fighter states must be copyable as bytes.");
+    static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "The snapshot header must be copyable as bytes.");
+    static_assert(sizeof(FighterState) == 32, "Fighter states must not carry padding of unknown content.");
+
+/**
+ * @brief Constructs an empty snapshot, to capture into later.
+ */
+    BattleSnapshot::BattleSnapshot() : header() {}
+
+/**
+ * @brief Constructs a snapshot of the current state of two teams.
+ * @param teamA The first team.
+ * @param teamB The second team.
+ * @throws std::invalid_argument If a team is led by a fighter of neither roster.
+ */
+    BattleSnapshot::BattleSnapshot(const Team &teamA, const Team &teamB) : header() {
+        capture(teamA, teamB);
+    }
+
+/**
+ * @brief Finds the leader of a team among the states of both rosters.
+ * @param team The team whose leader is looked for.
+ * @param teamA The first team of the snapshot.
+ * @param teamB The second team of the snapshot.
+ * @return The index of the leader in the states.
+ * @throws std::invalid_argument If the leader is in neither roster.
+ */
+    std::uint32_t BattleSnapshot::leaderIndex(const Team &team, const Team &teamA, const Team &teamB) const {
+        const Character *leader = team.getLeader();
+        // The slot given by the observed team, checked against both rosters
+        std::size_t slot = leader->getObserverSlot();
+        if (slot < teamA.getFighters().size() && teamA.getFighters()[slot] == leader) {
+            return static_cast<std::uint32_t>(slot);
+        }
+        if (slot < teamB.getFighters().size() && teamB.getFighters()[slot] == leader) {
+            return static_cast<std::uint32_t>(teamA.getFighters().size() + slot);
+        }
+        throw std::invalid_argument("Error: A team is led by a fighter of neither team.");
+    }
+
+/**
+ * @brief Finds the fighter at an index of the states of both rosters.
+ * @param index The index in the states, team A first.
+ * @param teamA The first team.
+ * @param teamB The second team.
+ * @return The fighter.
+ */
+    Character *BattleSnapshot::leaderAt(std::uint32_t index, const Team &teamA, const Team &teamB) const {
+        return index < this->header.sizeA ? teamA.getFighters()[index]
+                                          : teamB.getFighters()[index - this->header.sizeA];
+    }
+
+/**
+ * @brief Records the current state of two teams, replacing the previous one. The memory of the previous capture
+ * is reused, so capturing the same teams over and over allocates nothing.
+ * @param teamA The first team.
+ * @param teamB The second team.
+ * @throws std::invalid_argument If a team is led by a fighter of neither roster.
+ */
+    void BattleSnapshot::capture(const Team &teamA, const Team &teamB) {
+        SnapshotHeader captured{};
+        captured.sizeA = static_cast<std::uint32_t>(teamA.getFighters().size());
+        captured.sizeB = static_cast<std::uint32_t>(teamB.getFighters().size());
+        captured.leaderA = leaderIndex(teamA, teamA, teamB);
+        captured.leaderB = leaderIndex(teamB, teamA, teamB);
+        this->header = captured;
+
+        this->states.resize(std::size_t{captured.sizeA} + captured.sizeB);
+        std::size_t index = 0;
+        for (const Team *team: {&teamA, &teamB}) {
+            for (const Character *fighter: team->getFighters()) {
+                FighterState &state = this->states[index++];
+                state = FighterState{};
+                Point location = fighter->getLocation();
+                state.x = location.getX();
+                state.y = location.getY();
+                state.hitPoints = fighter->getHitPoints();
+                state.kind = fighter->kind;
+                state.teamMember = fighter->teamMember;
+                if (fighter->kind == FighterKind::Cowboy) {
+                    state.bullets = static_cast<const Cowboy *>(fighter)->getBullets();
+                } else {
+                    state.speed = static_cast<const Ninja *>(fighter)->getSpeed();
+                }
+            }
+        }
+    }
+
+/**
+ * @brief Puts two teams back in the state they were captured in: the location, hit points, bullets, speed and
+ * team membership of every fighter and the leader of both teams.
+ * The teams must be the ones captured, or teams with rosters of the same sizes and the same kinds of fighters.
+ * @param teamA The first team.
+ * @param teamB The second team.
+ * @throws std::invalid_argument If the rosters don't match the snapshot, nothing is restored then.
+ */
+    void BattleSnapshot::restore(Team &teamA, Team &teamB) const {
+        if (teamA.getFighters().size() != this->header.sizeA || teamB.getFighters().size() != this->header.sizeB) {
+            throw std::invalid_argument("Error: The snapshot was taken of other teams.");
+        }
+        std::size_t index = 0;
+        for (const Team *team: {&teamA, &teamB}) {
+            for (const Character *fighter: team->getFighters()) {
+                if (fighter->kind != this->states[index++].kind) {
+                    throw std::invalid_argument("Error: The snapshot was taken of other teams.");
+                }
+            }
+        }
+
+        index = 0;
+        for (const Team *team: {&teamA, &teamB}) {
+            for (Character *fighter: team->getFighters()) {
+                const FighterState &state = this->states[index++];
+                fighter->writeLocation(Point(state.x, state.y));
+                fighter->writeHitPoints(state.hitPoints);
+                fighter->teamMember = state.teamMember;
+                if (state.kind == FighterKind::Cowboy) {
+                    static_cast<Cowboy *>(fighter)->writeBullets(state.bullets);
+                } else {
+                    static_cast<Ninja *>(fighter)->writeSpeed(state.speed);
+                }
+            }
+        }
+        teamA.stateRestored(leaderAt(this->header.leaderA, teamA, teamB));
+        teamB.stateRestored(leaderAt(this->header.leaderB, teamA, teamB));
+    }
+
+/**
+ * @brief Getter for the sizes of the rosters and the leaders captured.
+ * @return The header of the snapshot.
+ */
+    const SnapshotHeader &BattleSnapshot::getHeader() const {
+        return this->header;
+    }
+
+/**
+ * @brief Getter for the states of the fighters, those of team A followed by those of team B in roster order.
+ * @return The states, contiguous and trivially copyable.
+ */
+    const std::vector<FighterState> &BattleSnapshot::getStates() const {
+        return this->states;
+    }
+
+/**
+ * @brief The size of the snapshot as a blob.
+ * @return The number of bytes of the header and the states.
+ */
+    std::size_t BattleSnapshot::bytes() const {
+        return sizeof(SnapshotHeader) + this->states.size() * sizeof(FighterState);
+    }
+
+}
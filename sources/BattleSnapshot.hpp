@@ -0,0 +1,74 @@
+/**
+ * @file BattleSnapshot.hpp
+ * @brief Snapshot and restore of the complete state of two teams fighting each other, to fork a battle and
+ * play alternatives from the same position.
+ * The state of every fighter is kept in a fixed-size FighterState, the fighters of both rosters in one contiguous
+ * array after a small SnapshotHeader, so a snapshot holds no pointers and copying it is a memcpy. Restoring writes
+ * the states back into the fighters and lets the teams rebuild their indexes lazily, without notifying them of
+ * every change.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_BATTLESNAPSHOT_HPP
+#define COWBOY_VS_NINJA_B_BATTLESNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Character.hpp"
+
+namespace ariel {
+
+    class Team;
+
+    struct FighterState {
+        double x;
+        double y;
+        std::int32_t hitPoints;
+        // The bullets of a cowboy, 0 for a ninja
+        std::int32_t bullets;
+        // The speed of a ninja, 0 for a cowboy
+        std::int32_t speed;
+        FighterKind kind;
+        bool teamMember;
+        std::uint16_t reserved;
+    };
+
+    struct SnapshotHeader {
+        std::uint32_t sizeA;
+        std::uint32_t sizeB;
+        // Indexes of the leaders in the states of both rosters, team A first: a team may be led by a fighter of
+        // the other team.
+        std::uint32_t leaderA;
+        std::uint32_t leaderB;
+    };
+
+    class BattleSnapshot {
+    private:
+        SnapshotHeader header;
+        std::vector<FighterState> states;
+
+        std::uint32_t leaderIndex(const Team &team, const Team &teamA, const Team &teamB) const;
+
+        Character *leaderAt(std::uint32_t index, const Team &teamA, const Team &teamB) const;
+
+    public:
+        BattleSnapshot();
+
+        BattleSnapshot(const Team &teamA, const Team &teamB);
+
+        void capture(const Team &teamA, const Team &teamB);
+
+        void restore(Team &teamA, Team &teamB) const;
+
+        const SnapshotHeader &getHeader() const;
+
+        const std::vector<FighterState> &getStates() const;
+
+        std::size_t bytes() const;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_BATTLESNAPSHOT_HPP
@@ -6,6 +6,11 @@
  */
 
 #include "Character.hpp"
+#include "FighterStore.hpp"
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include "UnitStats.hpp"
 
 namespace ariel {
 
@@ -13,15 +18,19 @@ namespace ariel {
  * @brief Constructs a Character object with the specified name and location.
  * @param name The name of the character.
  * @param location The location of the character.
+ * @param hitPoints The initial hit points of the character.
+ * @param kind Whether the character is a Cowboy or a Ninja.
  * @throw std::invalid_argument if the name is empty or if the location coordinates are negative.
- * @throw std::out_of_range If the hit points is over or under the range of 0-150.
+ * @throw std::out_of_range If the hit points is over or under the range of 0 to maxHitPoints().
  */
-    Character::Character(const std::string &name, const ariel::Point &location, const int &hitPoints) :
-            location(location), hitPoints(hitPoints), name(name), teamMember(false) {
+    Character::Character(const std::string &name, const ariel::Point &location, const int &hitPoints,
+                         FighterKind kind) :
+            location(location), hitPoints(hitPoints), name(name), teamMember(false), kind(kind), arenaOwned(false),
+            observer(nullptr), observerSlot(0), store(nullptr), storeSlot(0) {
         if (name.empty()) {
             throw std::invalid_argument("Error: Name cannot be empty.");
         }
-        if (hitPoints < 0.0 || hitPoints > 150.0) {
+        if (hitPoints < 0.0 || hitPoints > maxHitPoints()) {
             throw std::out_of_range("Error: hitPoints out of bounds.");
         }
         this->location = location;
@@ -39,10 +48,57 @@ namespace ariel {
         if (NewHitPoints < 0) {
             throw std::invalid_argument("Error: Hit points must be a non-negative value.");
         }
-        if (NewHitPoints > 150) {
+        if (NewHitPoints > maxHitPoints()) {
             throw std::out_of_range("Error:hitPoints out of bounds.");
         }
-        this->hitPoints = NewHitPoints;
+        int previousHitPoints = getHitPoints();
+        writeHitPoints(NewHitPoints);
+        notifyHitPoints(previousHitPoints);
+    }
+
+/**
+ * @brief Stores a new location, in the slot of the store the character is bound to if it is, without telling the
+ * observer.
+ * @param newLocation The new location.
+ */
+    void Character::writeLocation(const Point &newLocation) {
+        if (this->store) {
+            this->store->x[this->storeSlot] = newLocation.getX();
+            this->store->y[this->storeSlot] = newLocation.getY();
+        } else {
+            this->location = newLocation;
+        }
+    }
+
+/**
+ * @brief Stores new hit points, in the slot of the store the character is bound to if it is, without telling the
+ * observer.
+ * @param newHitPoints The new hit points.
+ */
+    void Character::writeHitPoints(int newHitPoints) {
+        if (this->store) {
+            this->store->hitPoints[this->storeSlot] = newHitPoints;
+        } else {
+            this->hitPoints = newHitPoints;
+        }
+    }
+
+/**
+ * @brief Tells the observer when a change of hit points killed, revived or only hit the character.
+ * @param previousHitPoints The hit points before the change.
+ */
+    void Character::notifyHitPoints(int previousHitPoints) {
+        if (this->observer == nullptr) {
+            return;
+        }
+        int points = getHitPoints();
+        if (previousHitPoints > 0 && points <= 0) {
+            this->observer->fighterDied(this->observerSlot);
+        } else if (previousHitPoints <= 0 && points > 0) {
+            this->observer->fighterRevived(this->observerSlot);
+        } else if (previousHitPoints != points && points > 0) {
+            this->observer->fighterHit(this->observerSlot, points);
+        }
     }
 
 /**
@@ -50,7 +106,7 @@ namespace ariel {
  * @return True if the character has more than 0 hit points, indicating they are alive. False otherwise.
  */
     bool Character::isAlive() const {
-        return (this->hitPoints > 0);
+        return (getHitPoints() > 0);
     }
 
 /**
@@ -63,30 +119,40 @@ namespace ariel {
         if (!other) {
             throw std::invalid_argument("Error: Invalid pointer to character.");
         }
-        return this->location.distance(other->getLocation());
+        return getLocation().distance(other->getLocation());
     }
 
 /**
  * @brief reduces damage to the character by subtracting the specified amount from its hit points.
  * @param amount The amount of damage to be inflicted.
+ * @throw std::invalid_argument If the amount is negative.
  */
     void Character::hit(int amount) {
-        if (amount < 0) {
+        if (tryHit(amount) == CombatStatus::InvalidAmount) {
             throw std::invalid_argument("Error: amount must be non-negative.");
         }
+    }
 
-        this->hitPoints -= amount;
-
-        if (this->hitPoints < 0) {
-            this->hitPoints = 0;
+/**
+ * @brief Reduces the hit points of the character by the specified amount, down to 0, without throwing.
+ * @param amount The amount of damage to be inflicted.
+ * @return Done, or InvalidAmount if the amount is negative.
+ */
+    CombatStatus Character::tryHit(int amount) noexcept {
+        if (amount < 0) {
+            return CombatStatus::InvalidAmount;
         }
+        int previousHitPoints = getHitPoints();
+        writeHitPoints(std::max(0, previousHitPoints - amount));
+        notifyHitPoints(previousHitPoints);
+        return CombatStatus::Done;
     }
 
 /**
  * @brief Getter to the name field.
  * @return The name of the character.
  */
-    std::string Character::getName() const {
+    const std::string &Character::getName() const {
         return this->name;
     }
 
@@ -95,6 +161,9 @@ namespace ariel {
  * @return The location of the character.
  */
     Point Character::getLocation() const {
+        if (this->store) {
+            return Point(this->store->x[this->storeSlot], this->store->y[this->storeSlot]);
+        }
         return this->location;
     }
 
@@ -103,7 +172,7 @@ namespace ariel {
  * @return The value of the character hitPoints.
  */
     int Character::getHitPoints() const {
-        return this->hitPoints;
+        return this->store ? this->store->hitPoints[this->storeSlot] : this->hitPoints;
     }
 
 /**
@@ -123,16 +192,40 @@ namespace ariel {
         this->teamMember = newTeamMember;
     }
 
+/**
+ * @brief Checks if the Character lives in a FighterArena.
+ * @return true if the Character was created by FighterArena::create and must not be deleted.
+ */
+    bool Character::isArenaOwned() const {
+        return this->arenaOwned;
+    }
+
 /**
  * @brief Generates a string representation of the Character.
  * @return A string representation of the Character, including the name, hit points, and location.
  */
     std::string Character::print() const {
-        std::string characterInfo = "name: " + name + ", HitPoints: " + std::to_string(hitPoints) + ", location: ";
-        characterInfo += location.print();
+        std::string characterInfo;
+        printStats(characterInfo);
         return characterInfo;
     }
 
+/**
+ * @brief Appends the name, hit points, and location of the Character to a string, in the format of print(),
+ * without building temporary strings.
+ * @param out The string appended to, its capacity is reused.
+ */
+    void Character::printStats(std::string &out) const {
+        char digits[std::numeric_limits<int>::digits10 + 2];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), getHitPoints());
+        out += "name: ";
+        out += this->name;
+        out += ", HitPoints: ";
+        out.append(digits, result.ptr);
+        out += ", location: ";
+        getLocation().print(out);
+    }
+
 /**
  * @brief Setter for the location of the character.
  * @param newLocation The new location to set
@@ -142,6 +235,87 @@ namespace ariel {
         if (std::abs(newLocation.getX()) > DBL_MAX || std::abs(newLocation.getY()) > DBL_MAX) {
             throw std::out_of_range("Error: Invalid coordinates. Out of bounds.");
         }
-        this->location = newLocation;
+        Point previousLocation = getLocation();
+        writeLocation(newLocation);
+        if (this->observer != nullptr) {
+            this->observer->fighterMoved(this->observerSlot, previousLocation, newLocation);
+        }
+    }
+
+/**
+ * @brief Registers the observer told about moves, deaths and revivals of the character.
+ * @param newObserver The observer, usually the team of the character, nullptr to stop observing.
+ * @param slot The identifier of the character passed back to the observer.
+ */
+    void Character::setObserver(FighterObserver *newObserver, std::size_t slot) {
+        this->observer = newObserver;
+        this->observerSlot = slot;
+    }
+
+/**
+ * @brief Getter for the identifier the observer knows the character by.
+ * @return The slot of the character in the roster of its team, 0 if it was never observed.
+ */
+    std::size_t Character::getObserverSlot() const {
+        return this->observerSlot;
+    }
+
+/**
+ * @brief Copy constructor, the copy starts without an observer or a store and is not owned by an arena.
+ * @param other The character to copy.
+ */
+    Character::Character(const Character &other) : location(other.getLocation()), hitPoints(other.getHitPoints()),
+                                                   name(other.name), teamMember(other.teamMember),
+                                                   kind(other.kind), arenaOwned(false), observer(nullptr),
+                                                   observerSlot(0), store(nullptr), storeSlot(0) {}
+
+/**
+ * @brief Takes the location and hit points of another character, telling the observer about the move and then
+ * about the hit, death or revival, in the order a move followed by a hit would.
+ * @param other The character whose state is taken.
+ */
+    void Character::assignState(const Character &other) {
+        int previousHitPoints = getHitPoints();
+        setLocation(other.getLocation());
+        writeHitPoints(other.getHitPoints());
+        notifyHitPoints(previousHitPoints);
+    }
+
+/**
+ * @brief Copy assignment, the observer of this character is kept and told about the new location and hit points.
+ * @param other The character to copy.
+ * @return This character.
+ */
+    Character &Character::operator=(const Character &other) {
+        if (this != &other) {
+            assignState(other);
+            this->name = other.name;
+            this->teamMember = other.teamMember;
+        }
+        return *this;
+    }
+
+/**
+ * @brief Move constructor, the new character starts without an observer or a store and is not owned by an arena.
+ * @param other The character to move from.
+ */
+    Character::Character(Character &&other) noexcept: location(other.getLocation()),
+                                                      hitPoints(other.getHitPoints()), name(std::move(other.name)),
+                                                      teamMember(other.teamMember), kind(other.kind),
+                                                      arenaOwned(false), observer(nullptr), observerSlot(0),
+                                                      store(nullptr), storeSlot(0) {}
+
+/**
+ * @brief Move assignment, the observer of this character is kept and told about the new location and hit points.
+ * @param other The character to move from.
+ * @return This character.
+ */
+    Character &Character::operator=(Character &&other) {
+        if (this != &other) {
+            assignState(other);
+            this->name = std::move(other.name);
+            this->teamMember = other.teamMember;
+        }
+        return *this;
     }
 }
\ No newline at end of file
@@ -8,21 +8,118 @@
 #ifndef COWBOY_VS_NINJA_A_CHARACTER_HPP
 #define COWBOY_VS_NINJA_A_CHARACTER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include "Point.hpp"
 
 namespace ariel {
 
+    class FighterStore;
+
+    // Lets the attack loops dispatch on the type of a fighter with a plain branch instead of a dynamic_cast.
+    enum class FighterKind : std::uint8_t {
+        Cowboy,
+        Ninja
+    };
+
+    // The outcome of a combat action, returned by the try* methods instead of throwing. Those that move fighters or
+    // search a team may still let std::bad_alloc through, as the indexes kept of a team grow.
+    enum class CombatStatus : std::uint8_t {
+        Done,
+        // Allowed by the rules but without effect
+        OutOfBullets,
+        OutOfReach,
+        // Rejected, the throwing methods report these as exceptions
+        NullTarget,
+        SelfTarget,
+        AttackerDead,
+        TargetDead,
+        InvalidAmount,
+        SamePosition,
+        TeamEliminated
+    };
+
+    // True if the action was rejected.
+    constexpr bool failed(CombatStatus status) {
+        return status >= CombatStatus::NullTarget;
+    }
+
+    // Gets told about the changes of a fighter that derived state (indexes, counters) depends on.
+    class FighterObserver {
+    public:
+        FighterObserver() = default;
+
+        virtual ~FighterObserver() = default;
+
+        virtual void fighterMoved(std::size_t slot, const Point &from, const Point &to) = 0;
+
+        virtual void fighterDied(std::size_t slot) = 0;
+
+        virtual void fighterRevived(std::size_t slot) = 0;
+
+        // The hooks below do nothing by default, only observers ordering fighters by hit points need them.
+        // A change of hit points that neither killed nor revived the fighter.
+        virtual void fighterHit(std::size_t /*slot*/, int /*hitPoints*/) {}
+
+        // The state of every observed fighter was overwritten at once, without notifications.
+        virtual void fightersRestored() {}
+
+        // The observed fighters are about to be released with their team and must not be used any more.
+        virtual void fightersReleased() {}
+
+        // Make tidy make me do that
+        FighterObserver(const FighterObserver &other) = default;
+
+        FighterObserver &operator=(const FighterObserver &other) = default;
+
+        FighterObserver(FighterObserver &&other) = default;
+
+        FighterObserver &operator=(FighterObserver &&other) = default;
+    };
+
     class Character {
     private:
         Point location;
         int hitPoints;
         std::string name;
         bool teamMember;
+        FighterKind kind;
+        // Set for fighters constructed by a FighterArena, which releases them instead of their team.
+        bool arenaOwned;
+        FighterObserver *observer;
+        std::size_t observerSlot;
+        // The store holding the combat state of the character while it is bound to one, nullptr otherwise.
+        // A bound character is a view of its slot: location and hit points above are stale until it is released.
+        FighterStore *store;
+        std::size_t storeSlot;
+
+        void notifyHitPoints(int previousHitPoints);
+
+        void writeLocation(const Point &newLocation);
+
+        void writeHitPoints(int newHitPoints);
+
+        void assignState(const Character &other);
+
+        friend class FighterArena;
+        friend class BattleSnapshot;
+        friend class FighterStore;
+
+    protected:
+        void printStats(std::string &out) const;
+
+        FighterStore *boundStore() const {
+            return this->store;
+        }
+
+        std::size_t boundSlot() const {
+            return this->storeSlot;
+        }
 
     public:
-        Character(const std::string &name, const Point &location, const int &hitPoints);
+        Character(const std::string &name, const Point &location, const int &hitPoints, FighterKind kind);
 
         virtual ~Character() = default;
 
@@ -30,11 +127,18 @@ namespace ariel {
 
         bool isAlive() const;
 
+        // Defined here so that the dispatch in the attack loops inlines to a load and a compare.
+        FighterKind getKind() const {
+            return this->kind;
+        }
+
         double distance(const Character *other) const;
 
         void hit(int amount);
 
-        std::string getName() const;
+        CombatStatus tryHit(int amount) noexcept;
+
+        const std::string &getName() const;
 
         Point getLocation() const;
 
@@ -44,19 +148,27 @@ namespace ariel {
 
         void setTeamMember(bool newTeamMember);
 
+        bool isArenaOwned() const;
+
         void setLocation(Point newLocation);
 
+        void setObserver(FighterObserver *newObserver, std::size_t slot);
+
+        std::size_t getObserverSlot() const;
+
         virtual std::string print() const = 0;
 
+        virtual void print(std::string &out) const = 0;
 
-        // Make tidy make me do that
-        Character(const Character &other) = default;
+        // Make tidy make me do that. Copies are never observed by the team of the original, an assigned character
+        // keeps its own observer and notifies it like setLocation and setHitPoints would.
+        Character(const Character &other);
 
-        Character &operator=(const Character &other) = default;
+        Character &operator=(const Character &other);
 
-        Character(Character &&other) = default;
+        Character(Character &&other) noexcept;
 
-        Character &operator=(Character &&other) = default;
+        Character &operator=(Character &&other);
     };
 
 }
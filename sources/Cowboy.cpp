@@ -8,6 +8,7 @@
  */
 
 #include "Cowboy.hpp"
+#include "FighterStore.hpp"
 
 namespace ariel {
 /**
@@ -17,14 +18,14 @@ namespace ariel {
 * @throws std::invalid_argument if the name is empty.
 * @throw std::out_of_range if the hit points over 110 or less then 0.
 */
-    Cowboy::Cowboy(const std::string &name, const ariel::Point &location) : Character(name, location, 110) {
+    Cowboy::Cowboy(const std::string &name, const ariel::Point &location) : Character(name, location, HIT_POINTS, FighterKind::Cowboy) {
         if (name.empty()) {
             throw std::invalid_argument("Error: Name cannot be empty.");
         }
-        if (this->getHitPoints() < 0 || this->getHitPoints() > 110) {
+        if (this->getHitPoints() < 0 || this->getHitPoints() > HIT_POINTS) {
             throw std::out_of_range("Error: hitPoints of Cowboy out of bounds.");
         }
-        this->bullets = 6;
+        this->bullets = MAGAZINE_SIZE;
     }
 
 /**
@@ -32,28 +33,53 @@ namespace ariel {
  * @param enemy A pointer to the enemy character to shoot.
  * @throw std::invalid_argument If the enemy pointer is nullptr.
  * @throw std::runtimer_error If cowboy try shoot himself.
- * @throw std::out_of_range If the cowboy is out of bullets.
  * @throw std::runtime_error If the enemy is already dead.
  */
     void Cowboy::shoot(Character *other) {
-        if (other == nullptr)
-            throw std::invalid_argument("error: enemey can't be null");
-        if (this == other)
-            throw std::runtime_error("error: can't shoot myself");
-        if (!(this->isAlive()) || !(other->isAlive()))
-            throw std::runtime_error("error: me or enemy - already dead");
-        if (this->hasboolets()) {
-            this->bullets--;
-            other->hit(10);
+        switch (tryShoot(other)) {
+            case CombatStatus::NullTarget:
+                throw std::invalid_argument("error: enemey can't be null");
+            case CombatStatus::SelfTarget:
+                throw std::runtime_error("error: can't shoot myself");
+            case CombatStatus::AttackerDead:
+            case CombatStatus::TargetDead:
+                throw std::runtime_error("error: me or enemy - already dead");
+            default:
+                break;
         }
     }
 
+/**
+ * @brief Shoots the enemy character without throwing, an empty gun does nothing.
+ * @param other A pointer to the enemy character to shoot.
+ * @return Done, OutOfBullets, or why the shot was rejected: NullTarget, SelfTarget, AttackerDead or TargetDead.
+ */
+    CombatStatus Cowboy::tryShoot(Character *other) noexcept {
+        if (other == nullptr) {
+            return CombatStatus::NullTarget;
+        }
+        if (this == other) {
+            return CombatStatus::SelfTarget;
+        }
+        if (!(this->isAlive())) {
+            return CombatStatus::AttackerDead;
+        }
+        if (!(other->isAlive())) {
+            return CombatStatus::TargetDead;
+        }
+        if (!this->hasboolets()) {
+            return CombatStatus::OutOfBullets;
+        }
+        writeBullets(getBullets() - 1);
+        return other->tryHit(SHOT_DAMAGE);
+    }
+
 /**
 * @brief Checks if the cowboy has bullets left.
 * @return True if the cowboy has bullets, false otherwise.
 */
     bool Cowboy::hasboolets() const {
-        return (this->bullets > 0);
+        return (getBullets() > 0);
     }
 
 /**
@@ -61,10 +87,21 @@ namespace ariel {
  * @throw std::runtimer_error If the cowboy is not alive and try to reload.
  */
     void Cowboy::reload() {
-        if (!(this->isAlive())) {
+        if (tryReload() == CombatStatus::AttackerDead) {
             throw std::runtime_error("Error: Cowboy is not alive. Cannot reload.");
         }
-        this->bullets = 6;
+    }
+
+/**
+ * @brief Reloads the cowboy's gun with six new bullets without throwing.
+ * @return Done, or AttackerDead if the cowboy is not alive.
+ */
+    CombatStatus Cowboy::tryReload() noexcept {
+        if (!(this->isAlive())) {
+            return CombatStatus::AttackerDead;
+        }
+        writeBullets(MAGAZINE_SIZE);
+        return CombatStatus::Done;
     }
 
 /**
@@ -72,7 +109,72 @@ namespace ariel {
  * @return The number of bullets the Cowboy has.
  */
     int Cowboy::getBullets() const {
-        return this->bullets;
+        const FighterStore *store = boundStore();
+        return store ? store->bullets[boundSlot()] : this->bullets;
+    }
+
+/**
+ * @brief Stores the number of bullets, in the slot of the store the cowboy is bound to if it is.
+ * @param newBullets The number of bullets left in the gun.
+ */
+    void Cowboy::writeBullets(int newBullets) {
+        FighterStore *store = boundStore();
+        if (store) {
+            store->bullets[boundSlot()] = newBullets;
+        } else {
+            this->bullets = newBullets;
+        }
+    }
+
+/**
+ * @brief Setter for the bullets field.
+ * @param newBullets The number of bullets left in the gun.
+ * @throw std::out_of_range If the number of bullets is negative or more than a full gun.
+ */
+    void Cowboy::setBullets(int newBullets) {
+        if (newBullets < 0 || newBullets > MAGAZINE_SIZE) {
+            throw std::out_of_range("Error: bullets out of bounds.");
+        }
+        writeBullets(newBullets);
+    }
+
+/**
+ * @brief Copy constructor, the copy gets the bullets of the original and starts unbound like any copied character.
+ * @param other The cowboy to copy.
+ */
+    Cowboy::Cowboy(const Cowboy &other) : Character(other), bullets(other.getBullets()) {}
+
+/**
+ * @brief Copy assignment, the bullets are stored where this cowboy keeps them.
+ * @param other The cowboy to copy.
+ * @return This cowboy.
+ */
+    Cowboy &Cowboy::operator=(const Cowboy &other) {
+        if (this != &other) {
+            Character::operator=(other);
+            writeBullets(other.getBullets());
+        }
+        return *this;
+    }
+
+/**
+ * @brief Move constructor, the new cowboy gets the bullets of the original and starts unbound.
+ * @param other The cowboy to move from.
+ */
+    Cowboy::Cowboy(Cowboy &&other) noexcept: Character(std::move(other)), bullets(other.getBullets()) {}
+
+/**
+ * @brief Move assignment, the bullets are stored where this cowboy keeps them.
+ * @param other The cowboy to move from.
+ * @return This cowboy.
+ */
+    Cowboy &Cowboy::operator=(Cowboy &&other) {
+        if (this != &other) {
+            int otherBullets = other.getBullets();
+            Character::operator=(std::move(other));
+            writeBullets(otherBullets);
+        }
+        return *this;
     }
 
 /**
@@ -81,6 +183,18 @@ namespace ariel {
  * @note If the cowboy is dead, the hit points and location will not be printed.
  */
     std::string Cowboy::print() const {
-        return "C, " + Character::print();
+        std::string text;
+        print(text);
+        return text;
+    }
+
+/**
+ * @brief Appends the information about the cowboy to a string, in the format of print(), without building
+ * temporary strings.
+ * @param out The string appended to, its capacity is reused.
+ */
+    void Cowboy::print(std::string &out) const {
+        out += "C, ";
+        printStats(out);
     }
 }
\ No newline at end of file
@@ -14,25 +14,55 @@
 #include <string>
 #include "Character.hpp"
 #include "Point.hpp"
+#include "UnitStats.hpp"
 
 namespace ariel {
 
     class Cowboy : public Character {
     private:
+        // Stale while the cowboy is bound to a FighterStore, like the state kept by Character
         int bullets;
 
+        void writeBullets(int newBullets);
+
+        friend class BattleSnapshot;
+        friend class FighterStore;
+
     public:
+        static constexpr int SHOT_DAMAGE = COWBOY_STATS.damage;
+        static constexpr int HIT_POINTS = COWBOY_STATS.hitPoints;
+        static constexpr int MAGAZINE_SIZE = COWBOY_STATS.magazine;
+
         Cowboy(const std::string &name, const Point &location);
 
         void shoot(Character *enemy);
 
+        CombatStatus tryShoot(Character *enemy) noexcept;
+
         bool hasboolets() const;
 
         void reload();
 
+        CombatStatus tryReload() noexcept;
+
         int getBullets() const;
 
+        void setBullets(int newBullets);
+
         std::string print() const override;
+
+        void print(std::string &out) const override;
+
+        // Make tidy make me do that. The bullets are taken through the view, like the state kept by Character.
+        Cowboy(const Cowboy &other);
+
+        Cowboy &operator=(const Cowboy &other);
+
+        Cowboy(Cowboy &&other) noexcept;
+
+        Cowboy &operator=(Cowboy &&other);
+
+        ~Cowboy() override = default;
     };
 }
 #endif //COWBOY_VS_NINJA_B_COWBOY_HPP
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * @file FighterArena.cpp
+ * @brief Implementation of the FighterArena class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "FighterArena.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ariel {
+
+/**
+ * @brief Constructs an empty arena, no memory is reserved before the first fighter is created.
+ * @param blockSize The size in bytes of the blocks fighters are carved from.
+ * @throws std::invalid_argument If the block size is 0.
+ */
+    FighterArena::FighterArena(std::size_t blockSize) : blockSize(blockSize), currentBlock(0), offset(0) {
+        if (blockSize == 0) {
+            throw std::invalid_argument("Error: The blocks of an arena cannot be empty.");
+        }
+    }
+
+/**
+ * @brief Destroys the fighters of the arena and releases its blocks.
+ */
+    FighterArena::~FighterArena() {
+        reset();
+    }
+
+/**
+ * @brief Destroys every fighter created since the last reset and rewinds the arena to its first block.
+ * The blocks are kept, so the next battle of the same size creates its fighters without allocating.
+ */
+    void FighterArena::reset() {
+        for (auto fighter = this->fighters.rbegin(); fighter != this->fighters.rend(); fighter++) {
+            (*fighter)->~Character();
+        }
+        this->fighters.clear();
+        this->currentBlock = 0;
+        this->offset = 0;
+    }
+
+/**
+ * @brief Getter for the number of fighters living in the arena.
+ * @return The number of fighters created since the last reset.
+ */
+    std::size_t FighterArena::size() const {
+        return this->fighters.size();
+    }
+
+/**
+ * @brief Getter for the memory held by the arena.
+ * @return The total size in bytes of the blocks of the arena.
+ */
+    std::size_t FighterArena::reservedBytes() const {
+        std::size_t total = 0;
+        for (const Block &block: this->blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+/**
+ * @brief Carves aligned memory out of the current block, moving on to the next block when it is full.
+ * A request larger than the block size gets a block of its own.
+ * @param size The number of bytes needed.
+ * @param alignment The alignment of the object, at most the alignment of new[].
+ * @return The address of the memory.
+ */
+    void *FighterArena::allocate(std::size_t size, std::size_t alignment) {
+        while (this->currentBlock < this->blocks.size()) {
+            Block &block = this->blocks[this->currentBlock];
+            std::size_t start = (this->offset + alignment - 1) / alignment * alignment;
+            if (start + size <= block.size) {
+                this->offset = start + size;
+                return block.memory.get() + start;
+            }
+            this->currentBlock++;
+            this->offset = 0;
+        }
+        std::size_t newSize = std::max(this->blockSize, size);
+        this->blocks.push_back(Block{std::make_unique<std::byte[]>(newSize), newSize});
+        this->currentBlock = this->blocks.size() - 1;
+        this->offset = size;
+        return this->blocks.back().memory.get();
+    }
+
+}
@@ -0,0 +1,85 @@
+/**
+ * @file FighterArena.hpp
+ * @brief A per-battle arena that fighters are constructed into instead of being allocated one by one with new.
+ * The arena carves fighters out of large blocks and never returns a block to the allocator before it is destroyed,
+ * so resetting it between battles turns the allocation and the release of a whole roster into pointer bumps.
+ * Fighters created by the arena are added to teams exactly like heap fighters; a team knows not to delete them.
+ * Every team holding arena fighters must be destroyed before the arena is reset or destroyed.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_FIGHTERARENA_HPP
+#define COWBOY_VS_NINJA_B_FIGHTERARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Character.hpp"
+
+namespace ariel {
+
+    class FighterArena {
+    public:
+        // Room for a few hundred fighters per block.
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit FighterArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+        ~FighterArena();
+
+        // Constructs a fighter of type T inside the arena, the arguments are those of the constructor of T.
+        template<typename T, typename... Args>
+        T *create(Args &&... args) {
+            static_assert(std::is_base_of_v<Character, T>, "Only fighters can be created in a fighter arena.");
+            void *memory = allocate(sizeof(T), alignof(T));
+            // The ownership slot is taken first, so that a fighter never exists without the arena destroying it
+            this->fighters.push_back(nullptr);
+            T *fighter;
+            try {
+                fighter = new(memory) T(std::forward<Args>(args)...);
+            } catch (...) {
+                this->fighters.pop_back();
+                throw;
+            }
+            fighter->arenaOwned = true;
+            this->fighters.back() = fighter;
+            return fighter;
+        }
+
+        void reset();
+
+        std::size_t size() const;
+
+        std::size_t reservedBytes() const;
+
+        FighterArena(const FighterArena &) = delete;
+
+        FighterArena &operator=(const FighterArena &) = delete;
+
+        FighterArena(FighterArena &&) = delete;
+
+        FighterArena &operator=(FighterArena &&) = delete;
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t size;
+        };
+
+        std::size_t blockSize;
+        std::vector<Block> blocks;
+        // The block being carved and the offset of its first free byte.
+        std::size_t currentBlock;
+        std::size_t offset;
+        std::vector<Character *> fighters;
+
+        void *allocate(std::size_t size, std::size_t alignment);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_FIGHTERARENA_HPP
@@ -0,0 +1,163 @@
+/**
+ * @file FighterStore.cpp
+ * @brief Implementation of the FighterStore class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "FighterStore.hpp"
+#include "Cowboy.hpp"
+#include "Ninja.hpp"
+#include "NearestKernel.hpp"
+
+namespace ariel {
+
+/**
+ * @brief Getter for the number of fighters in the store.
+ * @return The number of slots.
+ */
+    std::size_t FighterStore::size() const {
+        return this->hitPoints.size();
+    }
+
+/**
+ * @brief Checks if the fighter in a slot is alive.
+ * @param slot The slot of the fighter.
+ * @return True if the fighter has more than 0 hit points.
+ */
+    bool FighterStore::isAlive(std::size_t slot) const {
+        return this->hitPoints[slot] > 0;
+    }
+
+/**
+ * @brief Counts the living fighters with a single pass over the hit points array.
+ * @return The number of fighters with more than 0 hit points.
+ */
+    std::size_t FighterStore::countAlive() const {
+        std::size_t counter = 0;
+        for (int points: this->hitPoints) {
+            counter += points > 0 ? 1 : 0;
+        }
+        return counter;
+    }
+
+/**
+ * @brief Copies the combat state of a roster into the arrays, slot i holding fighters[i].
+ * @param fighters The roster.
+ * @throws std::invalid_argument If a fighter has an unknown kind.
+ */
+    void FighterStore::load(const std::vector<Character *> &fighters) {
+        const std::size_t count = fighters.size();
+        this->x.resize(count);
+        this->y.resize(count);
+        this->hitPoints.resize(count);
+        this->bullets.resize(count);
+        this->speed.resize(count);
+        this->kind.resize(count);
+        for (std::size_t slot = 0; slot < count; slot++) {
+            assign(slot, fighters[slot]);
+        }
+    }
+
+/**
+ * @brief Copies the combat state of a fighter into a slot of the arrays.
+ * @param slot The slot, already allocated in every array.
+ * @param fighter The fighter.
+ * @throws std::invalid_argument If the fighter has an unknown kind.
+ */
+    void FighterStore::assign(std::size_t slot, const Character *fighter) {
+        Point location = fighter->getLocation();
+        this->x[slot] = location.getX();
+        this->y[slot] = location.getY();
+        this->hitPoints[slot] = fighter->getHitPoints();
+        this->kind[slot] = fighter->getKind();
+        switch (fighter->getKind()) {
+            case FighterKind::Cowboy:
+                this->bullets[slot] = static_cast<const Cowboy *>(fighter)->getBullets();
+                this->speed[slot] = 0;
+                break;
+            case FighterKind::Ninja:
+                this->bullets[slot] = 0;
+                this->speed[slot] = static_cast<const Ninja *>(fighter)->getSpeed();
+                break;
+            default:
+                throw std::invalid_argument("Error: Unknown fighter type.");
+        }
+    }
+
+/**
+ * @brief Moves the combat state of a fighter into a new slot at the end of the arrays and makes the fighter a view
+ * of it, so that the store becomes the only copy of its state.
+ * @param fighter The fighter, not bound to any store.
+ * @throws std::invalid_argument If the fighter has an unknown kind or is already bound to a store.
+ */
+    void FighterStore::bind(Character *fighter) {
+        if (fighter->store != nullptr) {
+            throw std::invalid_argument("Error: The fighter is already bound to a store.");
+        }
+        const std::size_t slot = size();
+        this->x.emplace_back();
+        this->y.emplace_back();
+        this->hitPoints.emplace_back();
+        this->bullets.emplace_back();
+        this->speed.emplace_back();
+        this->kind.emplace_back();
+        assign(slot, fighter);
+        fighter->store = this;
+        fighter->storeSlot = slot;
+    }
+
+/**
+ * @brief Gives a fighter bound to the store its own copy of its state back. The slot stays in the store.
+ * @param fighter A fighter bound to this store, nothing happens for any other fighter.
+ */
+    void FighterStore::release(Character *fighter) {
+        if (fighter->store != this) {
+            return;
+        }
+        const std::size_t slot = fighter->storeSlot;
+        fighter->store = nullptr;
+        fighter->writeLocation(Point(this->x[slot], this->y[slot]));
+        fighter->writeHitPoints(this->hitPoints[slot]);
+        if (this->kind[slot] == FighterKind::Cowboy) {
+            static_cast<Cowboy *>(fighter)->writeBullets(this->bullets[slot]);
+        } else {
+            static_cast<Ninja *>(fighter)->writeSpeed(this->speed[slot]);
+        }
+    }
+
+/**
+ * @brief Writes the combat state of the arrays back to the Character objects they were loaded from.
+ * @param fighters The roster the store was loaded from.
+ */
+    void FighterStore::publish(const std::vector<Character *> &fighters) const {
+        for (std::size_t slot = 0; slot < fighters.size(); slot++) {
+            Character *fighter = fighters[slot];
+            if (fighter->getHitPoints() != this->hitPoints[slot]) {
+                fighter->setHitPoints(this->hitPoints[slot]);
+            }
+            if (this->kind[slot] == FighterKind::Cowboy) {
+                static_cast<Cowboy *>(fighter)->setBullets(this->bullets[slot]);
+            } else {
+                Point location = fighter->getLocation();
+                if (location.getX() != this->x[slot] || location.getY() != this->y[slot]) {
+                    fighter->setLocation(Point(this->x[slot], this->y[slot]));
+                }
+            }
+        }
+    }
+
+/**
+ * @brief Finds the living fighter closest to a location with the vectorized kernel over the coordinate arrays.
+ * Like Team::findClosestCharacter, the first of several equidistant fighters wins.
+ * @param fromX The x coordinate of the location.
+ * @param fromY The y coordinate of the location.
+ * @return The slot of the closest living fighter, npos if every fighter is dead.
+ */
+    std::size_t FighterStore::closestAlive(double fromX, double fromY) const {
+        std::size_t closest = NearestKernel::nearest(this->x.data(), this->y.data(), this->hitPoints.data(),
+                                                     this->size(), fromX, fromY);
+        return closest == NearestKernel::npos ? npos : closest;
+    }
+
+}
@@ -0,0 +1,56 @@
+/**
+ * @file FighterStore.hpp
+ * @brief Struct-of-arrays storage of the combat state of a roster.
+ * Each field of the fighters lives in its own contiguous array indexed by the fighter's slot in the roster,
+ * so the scans of the attack loop (liveness, nearest enemy) stream through memory instead of chasing pointers.
+ * A store is either a copy, loaded from and published back to the Character objects of a team, or the storage
+ * of the fighters bound to it: a bound Character reads and writes its location, hit points, bullets and speed in
+ * its slot, and only gets its own copy of them back when it is released.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_FIGHTERSTORE_HPP
+#define COWBOY_VS_NINJA_B_FIGHTERSTORE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "Character.hpp"
+
+namespace ariel {
+
+    class FighterStore {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<int> hitPoints;
+        std::vector<int> bullets;
+        std::vector<int> speed;
+        std::vector<FighterKind> kind;
+
+        std::size_t size() const;
+
+        bool isAlive(std::size_t slot) const;
+
+        std::size_t countAlive() const;
+
+        void load(const std::vector<Character *> &fighters);
+
+        void publish(const std::vector<Character *> &fighters) const;
+
+        std::size_t closestAlive(double fromX, double fromY) const;
+
+        void bind(Character *fighter);
+
+        void release(Character *fighter);
+
+    private:
+        void assign(std::size_t slot, const Character *fighter);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_FIGHTERSTORE_HPP
@@ -0,0 +1,287 @@
+/**
+ * @file FreeForAll.cpp
+ * @brief Implementation of the FreeForAll class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "FreeForAll.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "StrategyTeam.hpp"
+
+namespace ariel {
+
+    // Passes the changes of the fighters of one team on to the shared grid, in slots of the grid.
+    class FreeForAll::Watcher : public FighterObserver {
+    private:
+        FreeForAll *battle;
+        std::size_t index;
+
+    public:
+        Watcher(FreeForAll *battle, std::size_t index) : battle(battle), index(index) {}
+
+        void fighterMoved(std::size_t slot, const Point &from, const Point &to) override {
+            if (!this->battle->gridStale) {
+                this->battle->grid.move(this->battle->offsets[this->index] + slot, from.getX(), from.getY(),
+                                        to.getX(), to.getY());
+            }
+        }
+
+        void fighterDied(std::size_t slot) override {
+            if (!this->battle->gridStale) {
+                Point location = this->battle->teams[this->index]->getFighters()[slot]->getLocation();
+                this->battle->grid.erase(this->battle->offsets[this->index] + slot, location.getX(), location.getY());
+            }
+        }
+
+        void fighterRevived(std::size_t slot) override {
+            std::size_t gridSlot = this->battle->offsets[this->index] + slot;
+            if (this->battle->gridStale || gridSlot >= this->battle->offsets[this->index + 1]) {
+                // A fighter joined the team, the ranges of the following teams have to move
+                this->battle->gridStale = true;
+                return;
+            }
+            Point location = this->battle->teams[this->index]->getFighters()[slot]->getLocation();
+            this->battle->grid.insert(gridSlot, location.getX(), location.getY());
+        }
+
+        void fightersRestored() override {
+            this->battle->gridStale = true;
+        }
+
+        void fightersReleased() override {
+            this->battle->teams[this->index] = nullptr;
+            this->battle->gridStale = true;
+        }
+    };
+
+/**
+ * @brief Constructs a battle without teams.
+ */
+    FreeForAll::FreeForAll() : offsets{0}, gridStale(true), rounds(0) {}
+
+/**
+ * @brief Stops watching the teams that still exist.
+ */
+    FreeForAll::~FreeForAll() {
+        for (std::size_t index = 0; index < this->teams.size(); index++) {
+            if (this->teams[index]) {
+                this->teams[index]->removeWatcher(this->watchers[index].get());
+            }
+        }
+    }
+
+/**
+ * @brief Adds a team to the battle, hostile to every team already in it. The battle doesn't own the team, which
+ * must outlive it or be destroyed before the next round.
+ * @param team The team.
+ * @return The index of the team in the battle, its place in the order of the turns.
+ * @throws std::invalid_argument If the team is nullptr or already in the battle.
+ */
+    std::size_t FreeForAll::join(Team *team) {
+        if (!team) {
+            throw std::invalid_argument("Error: Cannot join a null team to the battle.");
+        }
+        if (std::find(this->teams.begin(), this->teams.end(), team) != this->teams.end()) {
+            throw std::invalid_argument("Error: The team is already in the battle.");
+        }
+        std::size_t index = this->teams.size();
+        this->watchers.push_back(std::make_unique<Watcher>(this, index));
+        this->teams.push_back(team);
+        this->offsets.push_back(this->offsets.back() + team->getFighters().size());
+        team->addWatcher(this->watchers.back().get());
+        this->gridStale = true;
+        return index;
+    }
+
+/**
+ * @brief Getter for the number of teams that joined the battle.
+ * @return The number of teams, eliminated ones included.
+ */
+    std::size_t FreeForAll::teamCount() const {
+        return this->teams.size();
+    }
+
+/**
+ * @brief Getter for a team of the battle.
+ * @param index The index returned when the team joined.
+ * @return The team, nullptr if it was destroyed.
+ * @throws std::out_of_range If no team joined with this index.
+ */
+    Team *FreeForAll::getTeam(std::size_t index) const {
+        if (index >= this->teams.size()) {
+            throw std::out_of_range("Error: No team joined the battle with this index.");
+        }
+        return this->teams[index];
+    }
+
+/**
+ * @brief Checks if a team still has living fighters.
+ * @param index The index of the team.
+ * @return True if the team exists and someone in it is alive.
+ */
+    bool FreeForAll::isStanding(std::size_t index) const {
+        return this->teams[index] && this->teams[index]->stillAlive() > 0;
+    }
+
+/**
+ * @brief Counts the teams that still have living fighters.
+ * @return The number of teams standing, the battle is over when it is 1 or less.
+ */
+    std::size_t FreeForAll::standing() const {
+        std::size_t count = 0;
+        for (std::size_t index = 0; index < this->teams.size(); index++) {
+            if (isStanding(index)) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+/**
+ * @brief Getter for the number of rounds played.
+ * @return The number of rounds.
+ */
+    int FreeForAll::getRounds() const {
+        return this->rounds;
+    }
+
+/**
+ * @brief Lays the rosters out in the grid again, each team after the previous one, and indexes the living fighters.
+ */
+    void FreeForAll::rebuild() {
+        std::vector<SpatialGrid::Entry> entries;
+        for (std::size_t index = 0; index < this->teams.size(); index++) {
+            const Team *team = this->teams[index];
+            std::size_t size = team ? team->getFighters().size() : 0;
+            this->offsets[index + 1] = this->offsets[index] + size;
+            for (std::size_t slot = 0; slot < size; slot++) {
+                const Character *fighter = team->getFighters()[slot];
+                if (fighter->isAlive()) {
+                    entries.push_back(SpatialGrid::Entry{this->offsets[index] + slot, fighter->getLocation().getX(),
+                                                         fighter->getLocation().getY()});
+                }
+            }
+        }
+        this->grid.build(entries);
+        this->gridStale = false;
+    }
+
+/**
+ * @brief Finds the team a slot of the grid belongs to.
+ * @param gridSlot The slot in the grid.
+ * @return The index of the team whose range holds the slot.
+ */
+    std::size_t FreeForAll::teamOf(std::size_t gridSlot) const {
+        return static_cast<std::size_t>(
+                std::upper_bound(this->offsets.begin(), this->offsets.end(), gridSlot) - this->offsets.begin()) - 1;
+    }
+
+/**
+ * @brief Finds the living fighter closest to a location among the enemies of a team, and the team it fights for.
+ * @param index The index of the team whose enemies are searched.
+ * @param location The location.
+ * @param owner Set to the team of the enemy found.
+ * @return The closest enemy, nullptr if every enemy is dead.
+ */
+    Character *FreeForAll::findEnemy(std::size_t index, const Point &location, Team *&owner) {
+        if (this->gridStale) {
+            rebuild();
+        }
+        std::size_t gridSlot = this->grid.nearest(location.getX(), location.getY(), this->offsets[index],
+                                                  this->offsets[index + 1]);
+        if (gridSlot == SpatialGrid::npos) {
+            return nullptr;
+        }
+        std::size_t ownerIndex = teamOf(gridSlot);
+        owner = this->teams[ownerIndex];
+        return owner->getFighters()[gridSlot - this->offsets[ownerIndex]];
+    }
+
+/**
+ * @brief Finds the living fighter closest to a location among the enemies of a team, in all the other teams.
+ * Ties go to the team that joined first, then to the fighter that joined its team first.
+ * @param index The index of the team whose enemies are searched.
+ * @param location The location.
+ * @return The closest enemy, nullptr if every enemy is dead.
+ * @throws std::out_of_range If no team joined with this index.
+ */
+    Character *FreeForAll::nearestEnemy(std::size_t index, const Point &location) {
+        if (index >= this->teams.size()) {
+            throw std::out_of_range("Error: No team joined the battle with this index.");
+        }
+        Team *owner = nullptr;
+        return findEnemy(index, location, owner);
+    }
+
+/**
+ * @brief The turn of a team: its living cowboys, then its living ninjas, act against the enemy closest to its
+ * leader, who is replaced as soon as it dies. Dead leaders of either side are replaced as in Team::attack.
+ * @param index The index of a standing team.
+ */
+    void FreeForAll::takeTurn(std::size_t index) {
+        Team *team = this->teams[index];
+        team->replaceDeadLeader();
+        Team *victimTeam = nullptr;
+        Character *victim = findEnemy(index, team->getLeader()->getLocation(), victimTeam);
+        if (!victim) {
+            return;
+        }
+        CowboysFirst::forEach(*team, [&](std::size_t slot) {
+            Character *attacker = team->getFighters()[slot];
+            if (!attacker->isAlive()) {
+                return true;
+            }
+            if (!victim->isAlive()) {
+                victim = findEnemy(index, team->getLeader()->getLocation(), victimTeam);
+                if (!victim) {
+                    return false;
+                }
+            }
+            team->act(attacker, victim);
+            if (victimTeam->stillAlive() > 0) {
+                Team::replaceDeadEnemyLeader(victimTeam);
+            }
+            return true;
+        });
+    }
+
+/**
+ * @brief Plays one round: every standing team takes its turn, starting with the team after the one that opened
+ * the previous round, until a single team is left.
+ * @return The number of teams still standing.
+ */
+    std::size_t FreeForAll::round() {
+        const std::size_t count = this->teams.size();
+        for (std::size_t turn = 0; turn < count && standing() > 1; turn++) {
+            std::size_t index = (static_cast<std::size_t>(this->rounds) + turn) % count;
+            if (isStanding(index)) {
+                takeTurn(index);
+            }
+        }
+        this->rounds++;
+        return standing();
+    }
+
+/**
+ * @brief Plays rounds until one team is left or a number of rounds was played.
+ * @param maxRounds The number of rounds after which the battle is a draw.
+ * @return The index of the last team standing, npos for a draw or if nobody is left.
+ */
+    std::size_t FreeForAll::run(int maxRounds) {
+        while (standing() > 1 && this->rounds < maxRounds) {
+            round();
+        }
+        if (standing() != 1) {
+            return npos;
+        }
+        for (std::size_t index = 0; index < this->teams.size(); index++) {
+            if (isStanding(index)) {
+                return index;
+            }
+        }
+        return npos;
+    }
+
+}
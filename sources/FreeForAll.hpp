@@ -0,0 +1,84 @@
+/**
+ * @file FreeForAll.hpp
+ * @brief A battle between any number of teams, every team hostile to every other one.
+ * The teams take turns in rounds, the team opening a round rotating from one round to the next. On its turn a
+ * team attacks like Team does, cowboys first, the victim being the living enemy closest to its leader in any
+ * other roster. The rosters of all teams share one SpatialGrid, each team owning a contiguous range of its slots,
+ * so finding the victim is one search of the grid leaving out the slots of the attacker, however many teams fight.
+ * The grid follows the fighters through the watchers of the teams.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_FREEFORALL_HPP
+#define COWBOY_VS_NINJA_B_FREEFORALL_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "SpatialGrid.hpp"
+#include "Team.hpp"
+
+namespace ariel {
+
+    class FreeForAll {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        FreeForAll();
+
+        ~FreeForAll();
+
+        std::size_t join(Team *team);
+
+        std::size_t teamCount() const;
+
+        Team *getTeam(std::size_t index) const;
+
+        std::size_t standing() const;
+
+        int getRounds() const;
+
+        Character *nearestEnemy(std::size_t index, const Point &location);
+
+        std::size_t round();
+
+        std::size_t run(int maxRounds);
+
+        // Make tidy make me write this
+        FreeForAll(const FreeForAll &) = delete;
+
+        FreeForAll &operator=(const FreeForAll &) = delete;
+
+        FreeForAll(FreeForAll &&) = delete;
+
+        FreeForAll &operator=(FreeForAll &&) = delete;
+
+    private:
+        class Watcher;
+
+        // nullptr once a team was destroyed
+        std::vector<Team *> teams;
+        std::vector<std::unique_ptr<Watcher>> watchers;
+        // The first slot of every team in the grid, and the end of the last range
+        std::vector<std::size_t> offsets;
+        SpatialGrid grid;
+        // Set when the grid can't follow a change, e.g. a fighter joining a team, and rebuilt on the next search.
+        bool gridStale;
+        int rounds;
+
+        bool isStanding(std::size_t index) const;
+
+        void rebuild();
+
+        std::size_t teamOf(std::size_t gridSlot) const;
+
+        Character *findEnemy(std::size_t index, const Point &location, Team *&owner);
+
+        void takeTurn(std::size_t index);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_FREEFORALL_HPP
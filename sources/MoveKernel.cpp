@@ -0,0 +1,134 @@
+/**
+ * @file MoveKernel.cpp
+ * @brief Implementation of the MoveKernel class.
+ * Every variant computes the step as source + speed * delta / distance with the same operations in the same order
+ * as Point::moveTowards, and square root and division are correctly rounded in SSE2 and AVX2 as well.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "MoveKernel.hpp"
+#include <cmath>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define ARIEL_MOVE_X86 1
+#endif
+
+namespace ariel {
+
+    namespace {
+
+        /**
+         * @brief Moves the units of the batch from a given position on, one at a time.
+         * @param start The first unit to move.
+         */
+        void scalarTail(double *xs, double *ys, const double *targetXs, const double *targetYs, const int *speeds,
+                        std::size_t count, std::size_t start) {
+            for (std::size_t i = start; i < count; i++) {
+                double dx = targetXs[i] - xs[i];
+                double dy = targetYs[i] - ys[i];
+                double distance = std::sqrt(dx * dx + dy * dy);
+                auto speed = static_cast<double>(speeds[i]);
+                if (distance <= speed) {
+                    xs[i] = targetXs[i];
+                    ys[i] = targetYs[i];
+                } else {
+                    xs[i] += speed * dx / distance;
+                    ys[i] += speed * dy / distance;
+                }
+            }
+        }
+
+#ifdef ARIEL_MOVE_X86
+
+        void advanceSse2(double *xs, double *ys, const double *targetXs, const double *targetYs, const int *speeds,
+                         std::size_t count) {
+            std::size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                __m128d x = _mm_loadu_pd(xs + i);
+                __m128d y = _mm_loadu_pd(ys + i);
+                __m128d targetX = _mm_loadu_pd(targetXs + i);
+                __m128d targetY = _mm_loadu_pd(targetYs + i);
+                __m128d speed = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(speeds + i)));
+                __m128d dx = _mm_sub_pd(targetX, x);
+                __m128d dy = _mm_sub_pd(targetY, y);
+                __m128d distance = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+                // Lanes that reach their target may divide by a zero distance, their step is discarded
+                __m128d steppedX = _mm_add_pd(x, _mm_div_pd(_mm_mul_pd(speed, dx), distance));
+                __m128d steppedY = _mm_add_pd(y, _mm_div_pd(_mm_mul_pd(speed, dy), distance));
+                __m128d reach = _mm_cmple_pd(distance, speed);
+                _mm_storeu_pd(xs + i, _mm_or_pd(_mm_and_pd(reach, targetX), _mm_andnot_pd(reach, steppedX)));
+                _mm_storeu_pd(ys + i, _mm_or_pd(_mm_and_pd(reach, targetY), _mm_andnot_pd(reach, steppedY)));
+            }
+            scalarTail(xs, ys, targetXs, targetYs, speeds, count, i);
+        }
+
+        __attribute__((target("avx2")))
+        void advanceAvx2(double *xs, double *ys, const double *targetXs, const double *targetYs, const int *speeds,
+                         std::size_t count) {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m256d x = _mm256_loadu_pd(xs + i);
+                __m256d y = _mm256_loadu_pd(ys + i);
+                __m256d targetX = _mm256_loadu_pd(targetXs + i);
+                __m256d targetY = _mm256_loadu_pd(targetYs + i);
+                __m256d speed = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(speeds + i)));
+                __m256d dx = _mm256_sub_pd(targetX, x);
+                __m256d dy = _mm256_sub_pd(targetY, y);
+                __m256d distance = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+                __m256d steppedX = _mm256_add_pd(x, _mm256_div_pd(_mm256_mul_pd(speed, dx), distance));
+                __m256d steppedY = _mm256_add_pd(y, _mm256_div_pd(_mm256_mul_pd(speed, dy), distance));
+                __m256d reach = _mm256_cmp_pd(distance, speed, _CMP_LE_OQ);
+                _mm256_storeu_pd(xs + i, _mm256_blendv_pd(steppedX, targetX, reach));
+                _mm256_storeu_pd(ys + i, _mm256_blendv_pd(steppedY, targetY, reach));
+            }
+            scalarTail(xs, ys, targetXs, targetYs, speeds, count, i);
+        }
+
+#endif
+
+    }
+
+/**
+ * @brief Moves every unit of a batch towards its target with the widest variant of the kernel.
+ * @param xs The x coordinates of the units, updated.
+ * @param ys The y coordinates of the units, updated.
+ * @param targetXs The x coordinates of the targets.
+ * @param targetYs The y coordinates of the targets.
+ * @param speeds The non-negative distance each unit may cover.
+ * @param count The number of units.
+ */
+    void MoveKernel::advance(double *xs, double *ys, const double *targetXs, const double *targetYs,
+                             const int *speeds, std::size_t count) {
+        advance(NearestKernel::bestLevel(), xs, ys, targetXs, targetYs, speeds, count);
+    }
+
+/**
+ * @brief Moves every unit of a batch towards its target with a given variant of the kernel.
+ * A unit standing on its target stays there. A variant the processor or the build does not support falls back
+ * to the next narrower one.
+ * @param level The variant to use.
+ * @param xs The x coordinates of the units, updated.
+ * @param ys The y coordinates of the units, updated.
+ * @param targetXs The x coordinates of the targets.
+ * @param targetYs The y coordinates of the targets.
+ * @param speeds The non-negative distance each unit may cover.
+ * @param count The number of units.
+ */
+    void MoveKernel::advance(Level level, double *xs, double *ys, const double *targetXs, const double *targetYs,
+                             const int *speeds, std::size_t count) {
+#ifdef ARIEL_MOVE_X86
+        if (level == Level::AVX2 && NearestKernel::bestLevel() == Level::AVX2) {
+            advanceAvx2(xs, ys, targetXs, targetYs, speeds, count);
+            return;
+        }
+        if (level != Level::Scalar) {
+            advanceSse2(xs, ys, targetXs, targetYs, speeds, count);
+            return;
+        }
+#endif
+        scalarTail(xs, ys, targetXs, targetYs, speeds, count, 0);
+    }
+
+}
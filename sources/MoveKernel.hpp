@@ -0,0 +1,33 @@
+/**
+ * @file MoveKernel.hpp
+ * @brief A batched movement step over packed coordinate arrays, vectorized with SSE2 or AVX2.
+ * Every unit of the batch walks towards its own target by its own speed, with the arithmetic of Point::moveTowards:
+ * a unit that can reach its target lands on it, the others advance by exactly their speed along the straight line.
+ * The results are bit-identical to moveTowards in every variant, without constructing points, range checks or
+ * exceptions, so whole rosters of ninjas can be moved in one pass.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_MOVEKERNEL_HPP
+#define COWBOY_VS_NINJA_B_MOVEKERNEL_HPP
+
+#include <cstddef>
+#include "NearestKernel.hpp"
+
+namespace ariel {
+
+    class MoveKernel {
+    public:
+        using Level = NearestKernel::Level;
+
+        static void advance(double *xs, double *ys, const double *targetXs, const double *targetYs,
+                            const int *speeds, std::size_t count);
+
+        static void advance(Level level, double *xs, double *ys, const double *targetXs, const double *targetYs,
+                            const int *speeds, std::size_t count);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_MOVEKERNEL_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file NearestKernel.cpp
+ * @brief Implementation of the NearestKernel class.
+ * Squared distances are computed as dx * dx + dy * dy with separate multiplications and additions in every
+ * variant, so all of them compare bit-identical values.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "NearestKernel.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define ARIEL_NEAREST_X86 1
+#endif
+
+namespace ariel {
+
+    namespace {
+
+        /**
+         * @brief Finishes a search from a given position, one candidate at a time.
+         * @param best The squared distance of the closest candidate before start, updated.
+         * @param bestIndex The index of that candidate, updated.
+         * @param start The first index to check.
+         */
+        void scalarTail(const double *xs, const double *ys, const int *alive, std::size_t count, double x, double y,
+                        std::size_t start, double &best, std::size_t &bestIndex) {
+            for (std::size_t i = start; i < count; i++) {
+                if (alive && alive[i] <= 0) {
+                    continue;
+                }
+                double dx = x - xs[i];
+                double dy = y - ys[i];
+                double squared = dx * dx + dy * dy;
+                if (squared < best) {
+                    best = squared;
+                    bestIndex = i;
+                }
+            }
+        }
+
+        /**
+         * @brief Merges the per-lane minimums of a vectorized search: smallest distance, then smallest index.
+         * Lanes that never found a candidate hold npos and lose every tie.
+         */
+        void mergeLanes(const double *laneBest, const std::uint64_t *laneIndex, std::size_t lanes, double &best,
+                        std::size_t &bestIndex) {
+            for (std::size_t lane = 0; lane < lanes; lane++) {
+                auto index = static_cast<std::size_t>(laneIndex[lane]);
+                if (laneBest[lane] < best || (laneBest[lane] == best && index < bestIndex)) {
+                    best = laneBest[lane];
+                    bestIndex = index;
+                }
+            }
+        }
+
+#ifdef ARIEL_NEAREST_X86
+
+        std::size_t nearestSse2(const double *xs, const double *ys, const int *alive, std::size_t count, double x,
+                                double y) {
+            const __m128d fromX = _mm_set1_pd(x);
+            const __m128d fromY = _mm_set1_pd(y);
+            const __m128d infinity = _mm_set1_pd(std::numeric_limits<double>::infinity());
+            const __m128i step = _mm_set1_epi64x(2);
+            __m128d best = _mm_set1_pd(std::numeric_limits<double>::max());
+            __m128i bestIndex = _mm_set1_epi64x(-1);
+            __m128i index = _mm_set_epi64x(1, 0);
+            std::size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                __m128d dx = _mm_sub_pd(fromX, _mm_loadu_pd(xs + i));
+                __m128d dy = _mm_sub_pd(fromY, _mm_loadu_pd(ys + i));
+                __m128d squared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+                if (alive) {
+                    __m128i points = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(alive + i));
+                    __m128i live = _mm_cmpgt_epi32(points, _mm_setzero_si128());
+                    __m128d mask = _mm_castsi128_pd(_mm_unpacklo_epi32(live, live));
+                    squared = _mm_or_pd(_mm_and_pd(mask, squared), _mm_andnot_pd(mask, infinity));
+                }
+                __m128d closer = _mm_cmplt_pd(squared, best);
+                best = _mm_or_pd(_mm_and_pd(closer, squared), _mm_andnot_pd(closer, best));
+                __m128i closerIndex = _mm_castpd_si128(closer);
+                bestIndex = _mm_or_si128(_mm_and_si128(closerIndex, index), _mm_andnot_si128(closerIndex, bestIndex));
+                index = _mm_add_epi64(index, step);
+            }
+            alignas(16) double laneBest[2];
+            alignas(16) std::uint64_t laneIndex[2];
+            _mm_store_pd(laneBest, best);
+            _mm_store_si128(reinterpret_cast<__m128i *>(laneIndex), bestIndex);
+            double result = std::numeric_limits<double>::max();
+            std::size_t resultIndex = NearestKernel::npos;
+            mergeLanes(laneBest, laneIndex, 2, result, resultIndex);
+            scalarTail(xs, ys, alive, count, x, y, i, result, resultIndex);
+            return resultIndex;
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t nearestAvx2(const double *xs, const double *ys, const int *alive, std::size_t count, double x,
+                                double y) {
+            const __m256d fromX = _mm256_set1_pd(x);
+            const __m256d fromY = _mm256_set1_pd(y);
+            const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+            const __m256i step = _mm256_set1_epi64x(4);
+            __m256d best = _mm256_set1_pd(std::numeric_limits<double>::max());
+            __m256i bestIndex = _mm256_set1_epi64x(-1);
+            __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m256d dx = _mm256_sub_pd(fromX, _mm256_loadu_pd(xs + i));
+                __m256d dy = _mm256_sub_pd(fromY, _mm256_loadu_pd(ys + i));
+                __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+                if (alive) {
+                    __m128i points = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alive + i));
+                    __m256i live = _mm256_cvtepi32_epi64(_mm_cmpgt_epi32(points, _mm_setzero_si128()));
+                    squared = _mm256_blendv_pd(infinity, squared, _mm256_castsi256_pd(live));
+                }
+                __m256d closer = _mm256_cmp_pd(squared, best, _CMP_LT_OQ);
+                best = _mm256_blendv_pd(best, squared, closer);
+                bestIndex = _mm256_castpd_si256(
+                        _mm256_blendv_pd(_mm256_castsi256_pd(bestIndex), _mm256_castsi256_pd(index), closer));
+                index = _mm256_add_epi64(index, step);
+            }
+            alignas(32) double laneBest[4];
+            alignas(32) std::uint64_t laneIndex[4];
+            _mm256_store_pd(laneBest, best);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(laneIndex), bestIndex);
+            double result = std::numeric_limits<double>::max();
+            std::size_t resultIndex = NearestKernel::npos;
+            mergeLanes(laneBest, laneIndex, 4, result, resultIndex);
+            scalarTail(xs, ys, alive, count, x, y, i, result, resultIndex);
+            return resultIndex;
+        }
+
+#endif
+
+    }
+
+/**
+ * @brief The widest variant of the kernel the processor can run, detected once.
+ * @return AVX2 or SSE2 on x86 processors, Scalar elsewhere.
+ */
+    NearestKernel::Level NearestKernel::bestLevel() {
+#ifdef ARIEL_NEAREST_X86
+        static const Level level = __builtin_cpu_supports("avx2") ? Level::AVX2 : Level::SSE2;
+        return level;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+/**
+ * @brief Finds the closest candidate to a location with the widest variant of the kernel.
+ * @param xs The x coordinates of the candidates.
+ * @param ys The y coordinates of the candidates.
+ * @param alive Per candidate, a positive value if it can be chosen (hit points fit). nullptr if all can.
+ * @param count The number of candidates.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The index of the first closest candidate, npos if there is none.
+ */
+    std::size_t NearestKernel::nearest(const double *xs, const double *ys, const int *alive, std::size_t count,
+                                       double x, double y) {
+        return nearest(bestLevel(), xs, ys, alive, count, x, y);
+    }
+
+/**
+ * @brief Finds the closest candidate to a location with a given variant of the kernel.
+ * A variant the processor or the build does not support falls back to the next narrower one.
+ * @param level The variant to use.
+ * @param xs The x coordinates of the candidates.
+ * @param ys The y coordinates of the candidates.
+ * @param alive Per candidate, a positive value if it can be chosen (hit points fit). nullptr if all can.
+ * @param count The number of candidates.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The index of the first closest candidate, npos if there is none.
+ */
+    std::size_t NearestKernel::nearest(Level level, const double *xs, const double *ys, const int *alive,
+                                       std::size_t count, double x, double y) {
+#ifdef ARIEL_NEAREST_X86
+        if (level == Level::AVX2 && bestLevel() == Level::AVX2) {
+            return nearestAvx2(xs, ys, alive, count, x, y);
+        }
+        if (level != Level::Scalar) {
+            return nearestSse2(xs, ys, alive, count, x, y);
+        }
+#endif
+        double best = std::numeric_limits<double>::max();
+        std::size_t bestIndex = npos;
+        scalarTail(xs, ys, alive, count, x, y, 0, best, bestIndex);
+        return bestIndex;
+    }
+
+}
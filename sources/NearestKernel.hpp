@@ -0,0 +1,42 @@
+/**
+ * @file NearestKernel.hpp
+ * @brief A batched nearest-point search over packed coordinate arrays, vectorized with SSE2 or AVX2.
+ * The search is a min-reduction of squared distances from one location to many candidates. Each SIMD lane keeps
+ * the first minimum it sees and the lanes are merged by distance then index, so the answer is always the first
+ * closest candidate in array order, exactly like Team::findClosestCharacter.
+ * The widest instruction set supported by the processor is picked at runtime, with a scalar loop as fallback.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_NEARESTKERNEL_HPP
+#define COWBOY_VS_NINJA_B_NEARESTKERNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ariel {
+
+    class NearestKernel {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        enum class Level : std::uint8_t {
+            Scalar,
+            SSE2,
+            AVX2
+        };
+
+        static Level bestLevel();
+
+        static std::size_t nearest(const double *xs, const double *ys, const int *alive, std::size_t count,
+                                   double x, double y);
+
+        static std::size_t nearest(Level level, const double *xs, const double *ys, const int *alive,
+                                   std::size_t count, double x, double y);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_NEARESTKERNEL_HPP
@@ -6,6 +6,7 @@
  */
 
 #include "Ninja.hpp"
+#include "FighterStore.hpp"
 
 namespace ariel{
 
@@ -16,7 +17,7 @@ namespace ariel{
  * @param speed The speed of the ninja.
  * @param hitPoints The hit points of the ninja.
  */
-Ninja::Ninja(const std::string& name, const Point& location, int speed , int hitPoints) : Character(name, location,hitPoints) , speed(speed) {
+Ninja::Ninja(const std::string& name, const Point& location, int speed , int hitPoints) : Character(name, location, hitPoints, FighterKind::Ninja) , speed(speed) {
     if (speed < 0) {
         throw std::invalid_argument("Error: Speed cannot be negative.");
     }
@@ -32,22 +33,36 @@ Ninja::Ninja(const std::string& name, const Point& location, int speed , int hit
  */
 
 void Ninja::move(ariel::Character *enemy) {
+    switch (tryMove(enemy)) {
+        case CombatStatus::NullTarget:
+            throw std::invalid_argument("Error: Invalid pointer to enemy character.");
+        case CombatStatus::SamePosition:
+            throw std::invalid_argument("Error: Invalid distance to enemy.");
+        default:
+            // A dead ninja doesn't move
+            break;
+    }
+}
+/**
+ * @brief Moves the Ninja towards the enemy by a distance equal to its speed, reporting a rejection as a status.
+ * @param enemy A pointer to the enemy Character.
+ * @return Done, or why the move was rejected: NullTarget, AttackerDead or SamePosition.
+ * @throws std::bad_alloc If the nearest-fighter index of the ninja's team can't grow to its new location.
+ */
+CombatStatus Ninja::tryMove(ariel::Character *enemy) {
     if (!enemy) {
-        throw std::invalid_argument("Error: Invalid pointer to enemy character.");
+        return CombatStatus::NullTarget;
     }
     if (!isAlive()) {
-        return;
-    }
-    double distance = getLocation().distance(enemy->getLocation());
-    if (distance <= 0) {
-        throw std::invalid_argument("Error: Invalid distance to enemy.");
+        return CombatStatus::AttackerDead;
     }
-    double movement = this->speed;
-    if (movement > distance) {
-        movement = distance;
+    if (getLocation().distanceSquared(enemy->getLocation()) <= 0) {
+        return CombatStatus::SamePosition;
     }
-    Point newLocation = Point::moveTowards(getLocation(), enemy->getLocation(), movement);
+    // moveTowards stops at the enemy when it is closer than the speed of the ninja
+    Point newLocation = Point::moveTowards(getLocation(), enemy->getLocation(), getSpeed());
     setLocation(newLocation);
+    return CombatStatus::Done;
 }
 /**
  * @brief Performs a slash attack on the enemy character.
@@ -56,18 +71,61 @@ void Ninja::move(ariel::Character *enemy) {
  * @throws std::runtime_error if the ninja is already dead or the ninja try to slash himself.
  */
 void Ninja::slash(ariel::Character *enemy) {
+    switch (trySlash(enemy)) {
+        case CombatStatus::NullTarget:
+            throw std::invalid_argument("Error: Invalid pointer to enemy character.");
+        case CombatStatus::SelfTarget:
+            throw std::runtime_error("Error: Ninja can't slash himself.");
+        case CombatStatus::AttackerDead:
+        case CombatStatus::TargetDead:
+            throw std::runtime_error("Error: Ninja is already dead.");
+        default:
+            break;
+    }
+}
+/**
+ * @brief Performs a slash attack on the enemy character without throwing, an enemy out of reach is not hurt.
+ * @param enemy A pointer to the enemy character.
+ * @return Done, OutOfReach, or why the slash was rejected: NullTarget, SelfTarget, AttackerDead or TargetDead.
+ */
+CombatStatus Ninja::trySlash(ariel::Character *enemy) noexcept {
     if (!enemy) {
-        throw std::invalid_argument("Error: Invalid pointer to enemy character.");
+        return CombatStatus::NullTarget;
+    }
+    if (this == enemy) {
+        return CombatStatus::SelfTarget;
+    }
+    if (!isAlive()) {
+        return CombatStatus::AttackerDead;
     }
-    if(this==enemy){
-        throw std::runtime_error("Error: Ninja can't slash himself.");
+    if (!(enemy->isAlive())) {
+        return CombatStatus::TargetDead;
     }
-    if (!isAlive() || !(enemy->isAlive())) {
-        throw std::runtime_error("Error: Ninja is already dead.");
+    if (!getLocation().withinRadius(enemy->getLocation(), SLASH_RANGE)) {
+        return CombatStatus::OutOfReach;
     }
-    double distance = getLocation().distance(enemy->getLocation());
-    if (distance < 1) {
-        enemy->hit(40);
+    return enemy->tryHit(SLASH_DAMAGE);
+}
+
+/**
+ * @brief Getter for the speed field.
+ * @return The distance the ninja covers in a single move.
+ */
+int Ninja::getSpeed() const {
+    const FighterStore *store = boundStore();
+    return store ? store->speed[boundSlot()] : this->speed;
+}
+
+/**
+ * @brief Stores the speed, in the slot of the store the ninja is bound to if it is.
+ * @param newSpeed The distance the ninja covers in a single move.
+ */
+void Ninja::writeSpeed(int newSpeed) {
+    FighterStore *store = boundStore();
+    if (store) {
+        store->speed[boundSlot()] = newSpeed;
+    } else {
+        this->speed = newSpeed;
     }
 }
 
@@ -76,6 +134,18 @@ void Ninja::slash(ariel::Character *enemy) {
  * @return A string representation of the Ninja.
  */
 std::string Ninja::print() const {
-    return " N, " + Character::print();
+    std::string text;
+    print(text);
+    return text;
+}
+
+/**
+ * @brief Appends the string representation of the Ninja to a string, in the format of print(), without building
+ * temporary strings.
+ * @param out The string appended to, its capacity is reused.
+ */
+void Ninja::print(std::string &out) const {
+    out += " N, ";
+    printStats(out);
 }
 }
\ No newline at end of file
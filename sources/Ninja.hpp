@@ -14,22 +14,40 @@
 #include <string>
 #include "Character.hpp"
 #include "Point.hpp"
+#include "UnitStats.hpp"
 
 namespace ariel {
 
     class Ninja : public Character {
     private:
+        // Stale while the ninja is bound to a FighterStore, like the state kept by Character
         int speed;
 
+        void writeSpeed(int newSpeed);
+
+        friend class BattleSnapshot;
+        friend class FighterStore;
+
     public:
+        static constexpr int SLASH_DAMAGE = NINJA_SLASH_DAMAGE;
+        static constexpr double SLASH_RANGE = NINJA_SLASH_RANGE;
+
         Ninja(const std::string &name, const Point &location, int speed, int hitPoints);
 
         void move(Character *enemy);
 
+        CombatStatus tryMove(Character *enemy);
+
         void slash(Character *enemy);
 
+        CombatStatus trySlash(Character *enemy) noexcept;
+
+        int getSpeed() const;
+
         std::string print() const override;
 
+        void print(std::string &out) const override;
+
     };
 }
 
@@ -10,12 +10,13 @@
 
 #include "Ninja.hpp"
 #include "Character.hpp"
+#include "UnitStats.hpp"
 
 namespace ariel{
     class OldNinja : public Ninja {
     private:
-        static const int OLD_NINJA_SPEED = 8;
-        static const int OLD_NINJA_HIT_POINTS = 150;
+        static constexpr int OLD_NINJA_SPEED = OLD_NINJA_STATS.speed;
+        static constexpr int OLD_NINJA_HIT_POINTS = OLD_NINJA_STATS.hitPoints;
     public:
         OldNinja(const std::string &name, const Point &location) : Ninja(name, location, OLD_NINJA_SPEED,OLD_NINJA_HIT_POINTS) {}
     };
@@ -0,0 +1,237 @@
+/**
+ * @file PackedTeam.cpp
+ * @brief Implementation of the PackedTeam class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "PackedTeam.hpp"
+#include "MoveKernel.hpp"
+#include <functional>
+
+namespace ariel {
+
+    namespace {
+        std::size_t slotOf(const std::vector<Character *> &fighters, const Character *fighter) {
+            std::size_t slot = fighter->getObserverSlot();
+            return slot < fighters.size() && fighters[slot] == fighter ? slot : FighterStore::npos;
+        }
+    }
+
+/**
+ * @brief Constructs a packed team with the specified leader, who is bound to the store of the team.
+ * @param leader Pointer to the leader of the team.
+ */
+    PackedTeam::PackedTeam(Character *leader) : Team(leader) {
+        this->store.bind(leader);
+    }
+
+/**
+ * @brief Constructs a packed team with the specified leader and roster size limit.
+ * @param leader Pointer to the leader of the team, who is bound to the store of the team.
+ * @param capacity The maximal number of fighters, Team::UNLIMITED for a large-roster team.
+ */
+    PackedTeam::PackedTeam(Character *leader, std::size_t capacity) : Team(leader, capacity) {
+        this->store.bind(leader);
+    }
+
+/**
+ * @brief Destructor, gives every fighter its state back before Team releases them, since the fighters of an arena
+ * outlive the team.
+ */
+    PackedTeam::~PackedTeam() {
+        for (Character *fighter: getFighters()) {
+            this->store.release(fighter);
+        }
+    }
+
+/**
+ * @brief Binds a fighter joining the team to the next slot of the store, which is its slot in the roster.
+ * @param fighter The new member of the team.
+ */
+    void PackedTeam::enlisted(Character *fighter) {
+        this->store.bind(fighter);
+    }
+
+/**
+ * @brief Getter for the storage of the fighters of the team, which their Character objects are views of.
+ * @return The struct-of-arrays state of the roster, slot i holding getFighters()[i].
+ */
+    const FighterStore &PackedTeam::getStore() const {
+        return this->store;
+    }
+
+/**
+ * @brief Moves the queued ninjas towards their targets with a single call of the movement kernel and empties the
+ * queue. The new locations are set through the fighters, so that the team keeps its indexes in step.
+ */
+    void PackedTeam::moveQueued() {
+        MoveKernel::advance(this->moverX.data(), this->moverY.data(), this->moverTargetX.data(),
+                            this->moverTargetY.data(), this->moverSpeed.data(), this->moverSlots.size());
+        const std::vector<Character *> &fighters = getFighters();
+        for (std::size_t i = 0; i < this->moverSlots.size(); i++) {
+            fighters[this->moverSlots[i]]->setLocation(Point(this->moverX[i], this->moverY[i]));
+        }
+        this->moverSlots.clear();
+        this->moverX.clear();
+        this->moverY.clear();
+        this->moverTargetX.clear();
+        this->moverTargetY.clear();
+        this->moverSpeed.clear();
+    }
+
+/**
+ * @brief Attacks the enemy team with the same rules and the same order of actions as Team::attack.
+ * The attack is resolved on the store of the team and the store of a packed enemy, which are the storage of their
+ * fighters, so nothing is loaded or published. A plain enemy team is copied into a scratch store first.
+ * Enemies don't move and only die during the attack, so the next victim is always the next living enemy in the
+ * (distance to leader, slot) order. That order is kept in a min-heap which is only rebuilt when the leader moves.
+ * A ninja acts once per attack and nothing reads its location afterwards, so the moves of all ninjas but the leader
+ * are queued and applied in one batch at the end of the attack. Leaders are replaced as soon as they die, as in
+ * Team::attack, so that the leader changes are recorded in the same place.
+ * @param enemyTeam Pointer to the enemy team.
+ * @return Done, or why the attack was rejected: NullTarget, SelfTarget or TeamEliminated.
+ * @throws std::bad_alloc If the stores of the rosters can't grow, the only exception it lets through.
+ */
+    CombatStatus PackedTeam::tryAttack(Team *enemyTeam) {
+        CombatStatus status = checkOpponent(enemyTeam);
+        if (failed(status)) {
+            return status;
+        }
+        auto *packedEnemy = dynamic_cast<PackedTeam *>(enemyTeam);
+        const std::vector<Character *> &fighters = this->getFighters();
+        const std::vector<Character *> &enemies = enemyTeam->getFighters();
+        if (!packedEnemy) {
+            this->enemyScratch.load(enemies);
+        }
+        FighterStore &enemy = packedEnemy ? packedEnemy->store : this->enemyScratch;
+
+        // A leader outside of the roster (appointed by another team) can't change during this attack.
+        Character *leader = this->getLeader();
+        std::size_t leaderSlot = slotOf(fighters, leader);
+        Point foreignLeaderLocation = leader->getLocation();
+        auto leaderX = [&] { return leaderSlot != FighterStore::npos ? store.x[leaderSlot] : foreignLeaderLocation.getX(); };
+        auto leaderY = [&] { return leaderSlot != FighterStore::npos ? store.y[leaderSlot] : foreignLeaderLocation.getY(); };
+        if (!(leaderSlot != FighterStore::npos ? this->store.isAlive(leaderSlot) : leader->isAlive())) {
+            leaderSlot = this->store.closestAlive(leaderX(), leaderY());
+            this->setLeader(fighters[leaderSlot]);
+        }
+
+        Character *enemyLeader = enemyTeam->getLeader();
+        std::size_t enemyLeaderSlot = slotOf(enemies, enemyLeader);
+        const bool foreignEnemyLeaderAlive = enemyLeader->isAlive();
+
+        // The events are recorded from the arrays, in the order and with the values Team records them
+        auto recordHit = [&](ReplayEvent event, std::size_t attacker, std::size_t target, int damage) {
+            int left = enemy.hitPoints[target] - damage;
+            record(event, attacker, target, damage, left > 0 ? left : 0);
+        };
+        // Through the fighter, so that the enemy team keeps its alive count and indexes and records the death
+        auto hit = [&](std::size_t target, int amount) {
+            enemies[target]->tryHit(amount);
+            if (!packedEnemy) {
+                enemy.hitPoints[target] = enemies[target]->getHitPoints();
+            }
+        };
+
+        bool victimOrderStale = true;
+        auto nextVictim = [&] {
+            auto farther = std::greater<std::pair<double, std::size_t>>();
+            if (victimOrderStale) {
+                this->victimQueue.clear();
+                double fromX = leaderX();
+                double fromY = leaderY();
+                for (std::size_t slot = 0; slot < enemy.size(); slot++) {
+                    if (enemy.isAlive(slot)) {
+                        double dx = fromX - enemy.x[slot];
+                        double dy = fromY - enemy.y[slot];
+                        this->victimQueue.emplace_back(dx * dx + dy * dy, slot);
+                    }
+                }
+                std::make_heap(this->victimQueue.begin(), this->victimQueue.end(), farther);
+                victimOrderStale = false;
+            }
+            while (!this->victimQueue.empty()) {
+                std::pop_heap(this->victimQueue.begin(), this->victimQueue.end(), farther);
+                std::size_t slot = this->victimQueue.back().second;
+                this->victimQueue.pop_back();
+                if (enemy.isAlive(slot)) {
+                    return slot;
+                }
+            }
+            return FighterStore::npos;
+        };
+
+        std::size_t victim = nextVictim();
+        for (FighterKind phase: {FighterKind::Cowboy, FighterKind::Ninja}) {
+            for (std::size_t slot = 0; slot < fighters.size(); slot++) {
+                if (!enemy.isAlive(victim)) {
+                    victim = nextVictim();
+                }
+                if (this->store.isAlive(slot) && enemy.isAlive(victim) && this->store.kind[slot] == phase) {
+                    if (phase == FighterKind::Cowboy) {
+                        if (this->store.bullets[slot] > 0) {
+                            this->store.bullets[slot]--;
+                            if (recording()) {
+                                recordHit(ReplayEvent::Shoot, slot, victim, Cowboy::SHOT_DAMAGE);
+                            }
+                            hit(victim, Cowboy::SHOT_DAMAGE);
+                        } else {
+                            this->store.bullets[slot] = Cowboy::MAGAZINE_SIZE;
+                            record(ReplayEvent::Reload, slot, ReplayRecord::NONE, this->store.x[slot],
+                                   this->store.y[slot]);
+                        }
+                    } else {
+                        double dx = enemy.x[victim] - this->store.x[slot];
+                        double dy = enemy.y[victim] - this->store.y[slot];
+                        double squared = dx * dx + dy * dy;
+                        if (squared < Ninja::SLASH_RANGE * Ninja::SLASH_RANGE) {
+                            if (recording()) {
+                                recordHit(ReplayEvent::Slash, slot, victim, Ninja::SLASH_DAMAGE);
+                            }
+                            hit(victim, Ninja::SLASH_DAMAGE);
+                        } else {
+                            if (recording()) {
+                                // The move itself is batched, its destination is worked out for the log alone
+                                Point destination = Point::moveTowards(
+                                        Point(this->store.x[slot], this->store.y[slot]),
+                                        Point(enemy.x[victim], enemy.y[victim]), this->store.speed[slot]);
+                                record(ReplayEvent::Move, slot, victim, destination.getX(), destination.getY());
+                            }
+                            this->moverSlots.push_back(slot);
+                            this->moverX.push_back(this->store.x[slot]);
+                            this->moverY.push_back(this->store.y[slot]);
+                            this->moverTargetX.push_back(enemy.x[victim]);
+                            this->moverTargetY.push_back(enemy.y[victim]);
+                            this->moverSpeed.push_back(this->store.speed[slot]);
+                            // The victim heap is ordered around the leader, which must stand at its new place
+                            if (slot == leaderSlot) {
+                                this->moveQueued();
+                            }
+                        }
+                        if (slot == leaderSlot) {
+                            victimOrderStale = true;
+                        }
+                    }
+                }
+                if (enemyTeam->stillAlive() == 0) {
+                    this->moveQueued();
+                    return CombatStatus::Done;
+                }
+                bool enemyLeaderAlive = enemyLeaderSlot != FighterStore::npos ? enemy.isAlive(enemyLeaderSlot)
+                                                                              : foreignEnemyLeaderAlive;
+                if (!enemyLeaderAlive) {
+                    double fromX = enemyLeaderSlot != FighterStore::npos ? enemy.x[enemyLeaderSlot]
+                                                                         : enemyLeader->getLocation().getX();
+                    double fromY = enemyLeaderSlot != FighterStore::npos ? enemy.y[enemyLeaderSlot]
+                                                                         : enemyLeader->getLocation().getY();
+                    enemyLeaderSlot = enemy.closestAlive(fromX, fromY);
+                    enemyTeam->setLeader(enemies[enemyLeaderSlot]);
+                }
+            }
+        }
+        this->moveQueued();
+        return CombatStatus::Done;
+    }
+
+}
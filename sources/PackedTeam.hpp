@@ -0,0 +1,69 @@
+/**
+ * @file PackedTeam.hpp
+ * @brief Contains the declaration of the PackedTeam class.
+ * A PackedTeam plays by the rules of Team (cowboys first, then ninjas, all attacking the enemy closest to the leader),
+ * but keeps the combat state of its fighters in a struct-of-arrays FighterStore and runs its attack loop over it.
+ * Its fighters are bound to the store when they join: their Character objects stay the public API of the team but
+ * are views of their slots, so an attack between two packed teams copies neither roster. The state of a plain
+ * enemy team lives in its fighters and is copied into a scratch store once per attack.
+ * Hits are dealt and moves made through the Character views, so the enemy team and its watchers hear of them as
+ * they happen. A recording packed team logs the same events, in the same order, as a Team would.
+ * With an unlimited capacity it is the large-roster mode: an attack costs O(n log n) in the size of the rosters,
+ * since victims are drawn from a heap ordered by distance to the leader instead of rescanning the enemy roster.
+ * The ninjas that walk during an attack are queued and moved together by the vectorized MoveKernel at its end.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_PACKEDTEAM_HPP
+#define COWBOY_VS_NINJA_B_PACKEDTEAM_HPP
+
+#include "Team.hpp"
+#include "FighterStore.hpp"
+#include <utility>
+#include <vector>
+
+namespace ariel {
+
+    class PackedTeam : public Team {
+    private:
+        FighterStore store;
+        FighterStore enemyScratch;
+        std::vector<std::pair<double, std::size_t>> victimQueue;
+        // The ninjas walking during the current attack, moved in one batch when it ends
+        std::vector<std::size_t> moverSlots;
+        std::vector<double> moverX;
+        std::vector<double> moverY;
+        std::vector<double> moverTargetX;
+        std::vector<double> moverTargetY;
+        std::vector<int> moverSpeed;
+
+        void moveQueued();
+
+    protected:
+        void enlisted(Character *fighter) override;
+
+    public:
+        PackedTeam(Character *leader);
+
+        PackedTeam(Character *leader, std::size_t capacity);
+
+        ~PackedTeam() override;
+
+        CombatStatus tryAttack(Team *enemyTeam) override;
+
+        const FighterStore &getStore() const;
+
+        // Make tidy make me write this
+        PackedTeam(const PackedTeam &) = delete;
+
+        PackedTeam &operator=(const PackedTeam &) = delete;
+
+        PackedTeam(PackedTeam &&) = delete;
+
+        PackedTeam &operator=(PackedTeam &&) = delete;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_PACKEDTEAM_HPP
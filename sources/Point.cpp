@@ -6,78 +6,44 @@
  */
 
 #include "Point.hpp"
+#include <charconv>
+#include <string>
 
 namespace ariel {
-/**
- * @brief Constructs a new Point object with the given x and y coordinates.
- * @param x The x coordinate.
- * @param y The y coordinate.
- * @throws std::invalid_argument if the coordinates are NaN, infinite, or out of bounds.
- */
-    Point::Point(double coordinate_x, double coordinate_y) {
-        if (coordinate_x > std::numeric_limits<double>::max() || coordinate_y < std::numeric_limits<double>::lowest()) {
-            throw std::out_of_range("Invalid coordinates: Out of bounds.");
-        }
-        this->coordinate_x = coordinate_x;
-        this->coordinate_y = coordinate_y;
-    }
-
-/**
-* @brief Returns the x coordinate of this position.
-* @return The x coordinate of this position.
-*/
-    double Point::getX() const {
-        return this->coordinate_x;
-    }
-
-/**
-* @brief Returns the y coordinate of this position.
-* @return The y coordinate of this position.
-*/
-    double Point::getY() const {
-        return this->coordinate_y;
-    }
 
-/**
- * @brief Set the x-coordinate of the point.
- * @param newX The new value for the x-coordinate.
- * @throw std::out_of_range if newX is out of bounds.
- */
-    void Point::setX(double newX) {
-        if (std::abs(newX) > DBL_MAX) {
-            throw std::out_of_range("Invalid coordinates: Out of bounds.");
-        }
-        this->coordinate_x = newX;
-    }
+    namespace {
+        // The longest fixed notation of a double: 309 integer digits, the sign, the point and the decimals
+        const std::size_t FIXED_CHARS = 320;
+        const int FIXED_DECIMALS = 6;
 
-/**
- * @brief Set the y-coordinate of the point.
- * @param newY The new value for the y-coordinate.
- * @throw std::out_of_range if newY is out of bounds.
- */
-    void Point::setY(double newY) {
-        if (std::abs(newY) > DBL_MAX) {
-            throw std::out_of_range("Invalid coordinates: Out of bounds.");
+        // Formats like std::to_string(double), which is specified as "%f", without the temporary string.
+        void appendFixed(std::string &out, double value) {
+            char digits[FIXED_CHARS];
+            std::to_chars_result result = std::to_chars(digits, digits + FIXED_CHARS, value,
+                                                        std::chars_format::fixed, FIXED_DECIMALS);
+            out.append(digits, result.ptr);
         }
-        this->coordinate_y = newY;
     }
 
 /**
-* @brief Calculates the Euclidean distance between this point and another point.
-* @param other The other position.
-* @return The distance between this position and the other position.
+* @brief Prints this position to standard output in the format [x, y].
 */
-    double Point::distance(const ariel::Point &other) const {
-        double dx = this->coordinate_x - other.coordinate_x;
-        double dy = this->coordinate_y - other.coordinate_y;
-        return std::sqrt(dx * dx + dy * dy);
+    std::string Point::print() const {
+        std::string text;
+        print(text);
+        return text;
     }
 
 /**
-* @brief Prints this position to standard output in the format [x, y].
+* @brief Appends this position to a string in the format of print(), without building temporary strings.
+* @param out The string appended to, its capacity is reused.
 */
-    std::string Point::print() const {
-        return "[" + std::to_string(this->coordinate_x) + "," + std::to_string(this->coordinate_y) + "]";
+    void Point::print(std::string &out) const {
+        out += '[';
+        appendFixed(out, this->coordinate_x);
+        out += ',';
+        appendFixed(out, this->coordinate_y);
+        out += ']';
     }
 
 /**
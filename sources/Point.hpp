@@ -2,6 +2,8 @@
  * @file Point.hpp
  * @brief Header file for the Point class - A class that will help us save a position on the game board.
  * The position is given as two double coordinates that keep the position of the unit along the x and y axes accordingly.
+ * Points are literal types and the geometry is defined inline, so positions can be laid out at compile time and
+ * the distance checks of the battle loops are inlined into their callers.
  * @author Tomer Gozlan
  * @date 12/05/2023
  */
@@ -11,6 +13,8 @@
 
 #include <iostream>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <bits/stdc++.h>
 
 namespace ariel {
@@ -22,23 +26,125 @@ namespace ariel {
         double coordinate_y;
     public:
 
-        Point(double coordinate_x, double coordinate_y);
+        constexpr Point(double coordinate_x, double coordinate_y);
 
-        double getX() const;
+        constexpr double getX() const;
 
-        double getY() const;
+        constexpr double getY() const;
 
-        void setX(double newX);
+        constexpr void setX(double newX);
 
-        void setY(double newY);
+        constexpr void setY(double newY);
 
         double distance(const Point &other) const;
 
+        constexpr double distanceSquared(const Point &other) const;
+
+        constexpr bool closerThan(const Point &first, const Point &second) const;
+
+        constexpr bool withinRadius(const Point &other, double radius) const;
+
         std::string print() const;
 
+        void print(std::string &out) const;
+
         static Point moveTowards(const Point &source, const Point &dest, double distance);
 
     };
+
+/**
+ * @brief Constructs a new Point object with the given x and y coordinates, at compile time when they are constants.
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @throws std::out_of_range if the coordinates are infinite.
+ */
+    constexpr Point::Point(double coordinate_x, double coordinate_y) : coordinate_x(coordinate_x),
+                                                                       coordinate_y(coordinate_y) {
+        if (coordinate_x > std::numeric_limits<double>::max() || coordinate_y < std::numeric_limits<double>::lowest()) {
+            throw std::out_of_range("Invalid coordinates: Out of bounds.");
+        }
+    }
+
+/**
+* @brief Returns the x coordinate of this position.
+* @return The x coordinate of this position.
+*/
+    constexpr double Point::getX() const {
+        return this->coordinate_x;
+    }
+
+/**
+* @brief Returns the y coordinate of this position.
+* @return The y coordinate of this position.
+*/
+    constexpr double Point::getY() const {
+        return this->coordinate_y;
+    }
+
+/**
+ * @brief Set the x-coordinate of the point.
+ * @param newX The new value for the x-coordinate.
+ * @throw std::out_of_range if newX is out of bounds.
+ */
+    constexpr void Point::setX(double newX) {
+        if (newX > std::numeric_limits<double>::max() || newX < std::numeric_limits<double>::lowest()) {
+            throw std::out_of_range("Invalid coordinates: Out of bounds.");
+        }
+        this->coordinate_x = newX;
+    }
+
+/**
+ * @brief Set the y-coordinate of the point.
+ * @param newY The new value for the y-coordinate.
+ * @throw std::out_of_range if newY is out of bounds.
+ */
+    constexpr void Point::setY(double newY) {
+        if (newY > std::numeric_limits<double>::max() || newY < std::numeric_limits<double>::lowest()) {
+            throw std::out_of_range("Invalid coordinates: Out of bounds.");
+        }
+        this->coordinate_y = newY;
+    }
+
+/**
+* @brief Calculates the Euclidean distance between this point and another point.
+* @param other The other position.
+* @return The distance between this position and the other position.
+*/
+    inline double Point::distance(const ariel::Point &other) const {
+        return std::sqrt(distanceSquared(other));
+    }
+
+/**
+* @brief Calculates the squared Euclidean distance between this point and another point.
+* Orders points exactly like distance() without paying for the square root, for comparisons only.
+* @param other The other position.
+* @return The squared distance between this position and the other position.
+*/
+    constexpr double Point::distanceSquared(const ariel::Point &other) const {
+        double dx = this->coordinate_x - other.coordinate_x;
+        double dy = this->coordinate_y - other.coordinate_y;
+        return dx * dx + dy * dy;
+    }
+
+/**
+* @brief Checks if a position is strictly closer to this position than another one.
+* @param first The position that should be closer.
+* @param second The position it is compared to.
+* @return True if first is closer to this position than second.
+*/
+    constexpr bool Point::closerThan(const ariel::Point &first, const ariel::Point &second) const {
+        return distanceSquared(first) < distanceSquared(second);
+    }
+
+/**
+* @brief Checks if another position is less than a given distance away from this position.
+* @param other The other position.
+* @param radius The distance, a negative radius contains nothing.
+* @return True if the distance between the positions is smaller than radius.
+*/
+    constexpr bool Point::withinRadius(const ariel::Point &other, double radius) const {
+        return radius > 0 && distanceSquared(other) < radius * radius;
+    }
 }
 
 #endif //COWBOY_VS_NINJA_A_POINT_HPP
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file ReplayReader.cpp
+ * @brief Implementation of the ReplayReader class on top of the POSIX mmap.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "ReplayReader.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ariel {
+
+/**
+ * @brief Maps a log into memory and checks its header.
+ * @param path The path of the log.
+ * @throws std::runtime_error If the file cannot be read or is not a replay log of this version.
+ */
+    ReplayReader::ReplayReader(const std::string &path) : mapping(nullptr), mappedBytes(0), records(nullptr),
+                                                          count(0) {
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error: Cannot read the replay log " + path + ".");
+        }
+        struct stat status{};
+        if (::fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(ReplayHeader))) {
+            ::close(descriptor);
+            throw std::runtime_error("Error: " + path + " is not a replay log.");
+        }
+        this->mappedBytes = static_cast<std::size_t>(status.st_size);
+        this->mapping = ::mmap(nullptr, this->mappedBytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);
+        if (this->mapping == MAP_FAILED) {
+            throw std::runtime_error("Error: Cannot read the replay log " + path + ".");
+        }
+
+        const auto *bytes = static_cast<const unsigned char *>(this->mapping);
+        const auto *header = reinterpret_cast<const ReplayHeader *>(bytes);
+        if (!std::equal(std::begin(ReplayHeader::MAGIC), std::end(ReplayHeader::MAGIC), header->magic) ||
+            header->version != ReplayHeader::VERSION || header->recordSize != sizeof(ReplayRecord)) {
+            ::munmap(this->mapping, this->mappedBytes);
+            throw std::runtime_error("Error: " + path + " is not a replay log of this version.");
+        }
+        // A record cut short by a crash of the writer is ignored
+        this->count = (this->mappedBytes - sizeof(ReplayHeader)) / sizeof(ReplayRecord);
+        this->records = reinterpret_cast<const ReplayRecord *>(bytes + sizeof(ReplayHeader));
+    }
+
+/**
+ * @brief Unmaps the log, the records must not be used afterwards.
+ */
+    ReplayReader::~ReplayReader() {
+        ::munmap(this->mapping, this->mappedBytes);
+    }
+
+/**
+ * @brief Getter for the number of records in the log.
+ * @return The number of complete records.
+ */
+    std::size_t ReplayReader::size() const {
+        return this->count;
+    }
+
+/**
+ * @brief Accesses a record in place.
+ * @param index The position of the record in the log.
+ * @return The record.
+ * @throws std::out_of_range If there is no such record.
+ */
+    const ReplayRecord &ReplayReader::operator[](std::size_t index) const {
+        if (index >= this->count) {
+            throw std::out_of_range("Error: The replay log has no such record.");
+        }
+        return this->records[index];
+    }
+
+/**
+ * @brief The first record, for range-based loops.
+ * @return A pointer to the first record in the mapping.
+ */
+    const ReplayRecord *ReplayReader::begin() const {
+        return this->records;
+    }
+
+/**
+ * @brief Past the last record, for range-based loops.
+ * @return A pointer past the last complete record.
+ */
+    const ReplayRecord *ReplayReader::end() const {
+        return this->records + this->count;
+    }
+
+}
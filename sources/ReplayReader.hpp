@@ -0,0 +1,52 @@
+/**
+ * @file ReplayReader.hpp
+ * @brief Reads a replay log written by a ReplayRecorder by mapping it into memory.
+ * The records are used in place, straight from the mapped file, so iterating a log copies nothing and a large
+ * log is paged in by the operating system as it is read. The log must have been written on a machine with the
+ * same byte order.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_REPLAYREADER_HPP
+#define COWBOY_VS_NINJA_B_REPLAYREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include "ReplayRecorder.hpp"
+
+namespace ariel {
+
+    class ReplayReader {
+    private:
+        void *mapping;
+        std::size_t mappedBytes;
+        const ReplayRecord *records;
+        std::size_t count;
+
+    public:
+        explicit ReplayReader(const std::string &path);
+
+        ~ReplayReader();
+
+        std::size_t size() const;
+
+        const ReplayRecord &operator[](std::size_t index) const;
+
+        const ReplayRecord *begin() const;
+
+        const ReplayRecord *end() const;
+
+        // Make tidy make me write this
+        ReplayReader(const ReplayReader &) = delete;
+
+        ReplayReader &operator=(const ReplayReader &) = delete;
+
+        ReplayReader(ReplayReader &&) = delete;
+
+        ReplayReader &operator=(ReplayReader &&) = delete;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_REPLAYREADER_HPP
@@ -0,0 +1,116 @@
+/**
+ * @file ReplayRecorder.cpp
+ * @brief Implementation of the ReplayRecorder class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "ReplayRecorder.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ariel {
+
+    static_assert(sizeof(ReplayRecord) == 32, "Replay records must keep their on-disk size.");
+    static_assert(sizeof(ReplayHeader) == 16, "The replay header must keep the records 8-byte aligned.");
+
+/**
+ * @brief Creates a log file, replacing an existing one, and writes its header.
+ * @param path The path of the log.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+    ReplayRecorder::ReplayRecorder(const std::string &path) : file(std::fopen(path.c_str(), "wb")),
+                                                              buffer(BUFFER_RECORDS), next(buffer.data()),
+                                                              end(buffer.data() + buffer.size()), round(0),
+                                                              written(0), roundStart(0), largestRound(0),
+                                                              writeFailed(false) {
+        if (!this->file) {
+            throw std::runtime_error("Error: Cannot write the replay log " + path + ".");
+        }
+        ReplayHeader header{};
+        std::copy(std::begin(ReplayHeader::MAGIC), std::end(ReplayHeader::MAGIC), header.magic);
+        header.version = ReplayHeader::VERSION;
+        header.recordSize = sizeof(ReplayRecord);
+        if (std::fwrite(&header, sizeof(header), 1, this->file) != 1) {
+            std::fclose(this->file);
+            throw std::runtime_error("Error: Cannot write the replay log " + path + ".");
+        }
+    }
+
+/**
+ * @brief Writes the buffered records and closes the log.
+ */
+    ReplayRecorder::~ReplayRecorder() {
+        writeBuffer();
+        std::fclose(this->file);
+    }
+
+/**
+ * @brief Starts the next round, the events recorded from now on carry its number.
+ * The buffered records are written first if the buffer has no room left for a round as large as the largest so
+ * far, and the buffer grows, up to MAX_BUFFER_RECORDS, if the round that ended did not fit in it.
+ */
+    void ReplayRecorder::nextRound() {
+        this->largestRound = std::max(this->largestRound, size() - this->roundStart);
+        auto buffered = static_cast<std::size_t>(this->next - this->buffer.data());
+        if (buffered + this->largestRound > this->buffer.size()) {
+            this->writeFailed = !writeBuffer() || this->writeFailed;
+            std::size_t fitting = std::min(std::max(this->buffer.size(), this->largestRound), MAX_BUFFER_RECORDS);
+            if (fitting > this->buffer.size()) {
+                this->buffer.resize(fitting);
+                this->next = this->buffer.data();
+                this->end = this->buffer.data() + this->buffer.size();
+            }
+        }
+        this->roundStart = size();
+        this->round++;
+    }
+
+/**
+ * @brief Getter for the current round.
+ * @return The number of calls to nextRound() so far.
+ */
+    std::uint32_t ReplayRecorder::getRound() const {
+        return this->round;
+    }
+
+/**
+ * @brief Writes out the buffer, filled in the middle of a round.
+ */
+    void ReplayRecorder::spill() noexcept {
+        this->writeFailed = !writeBuffer() || this->writeFailed;
+    }
+
+/**
+ * @brief Writes the buffered records to the file and empties the buffer.
+ * @return False if some of the records could not be written.
+ */
+    bool ReplayRecorder::writeBuffer() noexcept {
+        auto buffered = static_cast<std::size_t>(this->next - this->buffer.data());
+        bool complete = buffered == 0 ||
+                        std::fwrite(this->buffer.data(), sizeof(ReplayRecord), buffered, this->file) == buffered;
+        this->written += buffered;
+        this->next = this->buffer.data();
+        return complete;
+    }
+
+/**
+ * @brief Writes the buffered records to the file, so that a reader sees every event recorded so far.
+ * @throws std::runtime_error If some records, now or earlier, could not be written.
+ */
+    void ReplayRecorder::flush() {
+        bool complete = writeBuffer() && std::fflush(this->file) == 0;
+        if (!complete || this->writeFailed) {
+            throw std::runtime_error("Error: Cannot write the replay log.");
+        }
+    }
+
+/**
+ * @brief Getter for the number of events recorded.
+ * @return The number of records, written or still buffered.
+ */
+    std::size_t ReplayRecorder::size() const {
+        return this->written + static_cast<std::size_t>(this->next - this->buffer.data());
+    }
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file ReplayRecorder.hpp
+ * @brief Binary replay log of a battle: the record format and the recorder that writes it.
+ * A log is a ReplayHeader followed by fixed-size ReplayRecords in the order the events happened, in the byte order
+ * of the machine that wrote it. Teams report their events to the recorder they are given with Team::recordTo:
+ * the shots, slashes, moves and reloads of their fighters, the deaths of their fighters and the changes of their
+ * leader. Records are stored into a preallocated buffer and written at the start of a round, once the buffer has
+ * no room left for another round as large as the largest so far, so recording an event costs a few stores and a
+ * compare. The buffer grows between rounds to hold the largest round, a round larger than it is written in parts.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_REPLAYRECORDER_HPP
+#define COWBOY_VS_NINJA_B_REPLAYRECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ariel {
+
+    enum class ReplayEvent : std::uint8_t {
+        Shoot,
+        Slash,
+        Move,
+        Reload,
+        Death,
+        LeaderChange
+    };
+
+    struct ReplayRecord {
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t round;
+        ReplayEvent event;
+        // The side of the team that reported the event, as given to Team::recordTo
+        std::uint8_t team;
+        std::uint16_t reserved;
+        // Roster slots. Shoot, Slash, Move: the attacker and its victim. Reload: the cowboy.
+        // Death: the fighter that died. LeaderChange: the new leader and the previous one.
+        std::uint32_t actor;
+        std::uint32_t target;
+        // Shoot, Slash: the damage and the hit points left to the victim.
+        // Every other event: the location of the actor after the event.
+        double x;
+        double y;
+    };
+
+    struct ReplayHeader {
+        static constexpr char MAGIC[4] = {'C', 'V', 'N', 'R'};
+        static constexpr std::uint32_t VERSION = 1;
+
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t recordSize;
+        std::uint32_t reserved;
+    };
+
+    class ReplayRecorder {
+    private:
+        std::FILE *file;
+        // The records not written yet are [buffer.data(), next), the buffer is only resized between rounds
+        std::vector<ReplayRecord> buffer;
+        ReplayRecord *next;
+        ReplayRecord *end;
+        std::uint32_t round;
+        std::size_t written;
+        // The number of records at the start of the current round, and the most records a round had so far
+        std::size_t roundStart;
+        std::size_t largestRound;
+        bool writeFailed;
+
+        bool writeBuffer() noexcept;
+
+        void spill() noexcept;
+
+    public:
+        // The records the buffer starts with, and the most it grows to
+        static constexpr std::size_t BUFFER_RECORDS = 4096;
+        static constexpr std::size_t MAX_BUFFER_RECORDS = std::size_t{1} << 20;
+
+        explicit ReplayRecorder(const std::string &path);
+
+        ~ReplayRecorder();
+
+        void nextRound();
+
+        std::uint32_t getRound() const;
+
+        /**
+         * @brief Appends an event of the current round to the buffer, written out at the start of a later round.
+         * Defined here so that recording inlines into the attack loops.
+         * @param event The kind of event.
+         * @param team The side of the team reporting it.
+         * @param actor The roster slot of the fighter acting, or the one the event happened to.
+         * @param target The roster slot of the other fighter involved, ReplayRecord::NONE if there is none.
+         * @param x The first value of the event, see ReplayRecord.
+         * @param y The second value of the event.
+         */
+        void record(ReplayEvent event, std::uint8_t team, std::size_t actor, std::size_t target, double x,
+                    double y) noexcept {
+            ReplayRecord &entry = *this->next;
+            entry.round = this->round;
+            entry.event = event;
+            entry.team = team;
+            entry.reserved = 0;
+            entry.actor = actor > ReplayRecord::NONE ? ReplayRecord::NONE : static_cast<std::uint32_t>(actor);
+            entry.target = target > ReplayRecord::NONE ? ReplayRecord::NONE : static_cast<std::uint32_t>(target);
+            entry.x = x;
+            entry.y = y;
+            if (++this->next == this->end) {
+                spill();
+            }
+        }
+
+        void flush();
+
+        std::size_t size() const;
+
+        // Make tidy make me write this
+        ReplayRecorder(const ReplayRecorder &) = delete;
+
+        ReplayRecorder &operator=(const ReplayRecorder &) = delete;
+
+        ReplayRecorder(ReplayRecorder &&) = delete;
+
+        ReplayRecorder &operator=(ReplayRecorder &&) = delete;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_REPLAYRECORDER_HPP
@@ -0,0 +1,98 @@
+/**
+ * @file RosterGenerator.cpp
+ * @brief Implementation of the RosterGenerator class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "RosterGenerator.hpp"
+#include <stdexcept>
+
+namespace ariel {
+
+/**
+ * @brief Constructs a generator drawing from one stream of a seed.
+ * @param seed The seed shared by all the streams.
+ * @param stream The index of the stream, e.g. of a worker thread.
+ * @param minCoordinate The smallest coordinate a fighter can be placed at, on both axes.
+ * @param maxCoordinate The bound of the coordinates.
+ * @throws std::invalid_argument If the range of the coordinates is empty.
+ */
+    RosterGenerator::RosterGenerator(std::uint64_t seed, std::uint64_t stream, double minCoordinate,
+                                     double maxCoordinate) : random(seed, stream), minCoordinate(minCoordinate),
+                                                             maxCoordinate(maxCoordinate) {
+        if (!(minCoordinate < maxCoordinate)) {
+            throw std::invalid_argument("Error: The range of the coordinates is empty.");
+        }
+    }
+
+/**
+ * @brief Draws a coordinate uniformly from the range of the generator.
+ * @return The coordinate.
+ */
+    double RosterGenerator::coordinate() {
+        return this->random.uniform(this->minCoordinate, this->maxCoordinate);
+    }
+
+/**
+ * @brief Draws a location, x first and then y.
+ * @return The location.
+ */
+    Point RosterGenerator::location() {
+        double x = coordinate();
+        double y = coordinate();
+        return Point{x, y};
+    }
+
+/**
+ * @brief Draws one of the four unit types with equal probability.
+ * @return The unit type.
+ */
+    UnitType RosterGenerator::unitType() {
+        const UnitType types[] = {UnitType::Cowboy, UnitType::YoungNinja, UnitType::TrainedNinja, UnitType::OldNinja};
+        return types[this->random.below(4)];
+    }
+
+/**
+ * @brief Draws a fighter: its unit type, then its location.
+ * @return The description of the fighter.
+ */
+    FighterSpec RosterGenerator::fighter() {
+        UnitType type = unitType();
+        Point where = location();
+        return FighterSpec{type, "Bob", where.getX(), where.getY()};
+    }
+
+/**
+ * @brief Draws a roster of fighters, the first of which leads the team.
+ * @param type The strategy of the team.
+ * @param size The number of fighters.
+ * @return The roster.
+ * @throws std::invalid_argument If the roster would be empty.
+ */
+    TeamSpec RosterGenerator::team(TeamType type, std::size_t size) {
+        if (size == 0) {
+            throw std::invalid_argument("Error: A team needs at least a leader.");
+        }
+        TeamSpec spec{type, {}};
+        spec.roster.reserve(size);
+        for (std::size_t i = 0; i < size; i++) {
+            spec.roster.push_back(fighter());
+        }
+        return spec;
+    }
+
+/**
+ * @brief Draws a battle between two rosters of the same size, team A first.
+ * @param typeA The strategy of team A.
+ * @param typeB The strategy of team B.
+ * @param size The number of fighters on each side.
+ * @return The scenario, without jitter and with the default round limit.
+ */
+    Scenario RosterGenerator::scenario(TeamType typeA, TeamType typeB, std::size_t size) {
+        TeamSpec teamA = team(typeA, size);
+        TeamSpec teamB = team(typeB, size);
+        return Scenario{teamA, teamB};
+    }
+
+}
@@ -0,0 +1,48 @@
+/**
+ * @file RosterGenerator.hpp
+ * @brief Reproducible random rosters and scenarios.
+ * A generator draws unit types and locations from its own Xoshiro256 stream, so a (seed, stream) pair always
+ * produces the same rosters, and generators of different streams can run on different threads at the same time.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_ROSTERGENERATOR_HPP
+#define COWBOY_VS_NINJA_B_ROSTERGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "Point.hpp"
+#include "Scenario.hpp"
+#include "Xoshiro256.hpp"
+
+namespace ariel {
+
+    class RosterGenerator {
+    private:
+        Xoshiro256 random;
+        double minCoordinate;
+        double maxCoordinate;
+
+    public:
+        static constexpr double DEFAULT_BOUND = 100.0;
+
+        explicit RosterGenerator(std::uint64_t seed, std::uint64_t stream = 0, double minCoordinate = -DEFAULT_BOUND,
+                                 double maxCoordinate = DEFAULT_BOUND);
+
+        double coordinate();
+
+        Point location();
+
+        UnitType unitType();
+
+        FighterSpec fighter();
+
+        TeamSpec team(TeamType type, std::size_t size);
+
+        Scenario scenario(TeamType typeA, TeamType typeB, std::size_t size);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_ROSTERGENERATOR_HPP
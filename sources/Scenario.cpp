@@ -0,0 +1,84 @@
+/**
+ * @file Scenario.cpp
+ * @brief Factories that turn scenario descriptions into fighters and teams.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "Scenario.hpp"
+#include "Team2.hpp"
+#include "SmartTeam.hpp"
+#include "PackedTeam.hpp"
+
+namespace ariel {
+
+/**
+ * @brief Creates a heap allocated fighter from its description.
+ * @param spec The type, name and location of the fighter.
+ * @param offsetX Displacement added to the x coordinate of the spec.
+ * @param offsetY Displacement added to the y coordinate of the spec.
+ * @return A new fighter, owned by the caller until it is added to a team.
+ * @throws std::invalid_argument If the unit type is unknown.
+ */
+    Character *createFighter(const FighterSpec &spec, double offsetX, double offsetY) {
+        Point location(spec.x + offsetX, spec.y + offsetY);
+        switch (spec.type) {
+            case UnitType::Cowboy:
+                return new Cowboy(spec.name, location);
+            case UnitType::YoungNinja:
+                return new YoungNinja(spec.name, location);
+            case UnitType::TrainedNinja:
+                return new TrainedNinja(spec.name, location);
+            case UnitType::OldNinja:
+                return new OldNinja(spec.name, location);
+        }
+        throw std::invalid_argument("Error: Unknown unit type.");
+    }
+
+/**
+ * @brief Creates a fighter from its description inside an arena.
+ * @param spec The type, name and location of the fighter.
+ * @param arena The arena the fighter lives in, it stays there even after the fighter is added to a team.
+ * @param offsetX Displacement added to the x coordinate of the spec.
+ * @param offsetY Displacement added to the y coordinate of the spec.
+ * @return A new fighter, released when the arena is reset.
+ * @throws std::invalid_argument If the unit type is unknown.
+ */
+    Character *createFighter(const FighterSpec &spec, FighterArena &arena, double offsetX, double offsetY) {
+        Point location(spec.x + offsetX, spec.y + offsetY);
+        switch (spec.type) {
+            case UnitType::Cowboy:
+                return arena.create<Cowboy>(spec.name, location);
+            case UnitType::YoungNinja:
+                return arena.create<YoungNinja>(spec.name, location);
+            case UnitType::TrainedNinja:
+                return arena.create<TrainedNinja>(spec.name, location);
+            case UnitType::OldNinja:
+                return arena.create<OldNinja>(spec.name, location);
+        }
+        throw std::invalid_argument("Error: Unknown unit type.");
+    }
+
+/**
+ * @brief Creates a team of the requested strategy around a leader.
+ * @param type The team strategy: Team, Team2, SmartTeam or PackedTeam.
+ * @param leader The leader of the new team, ownership passes to the team.
+ * @param capacity The maximal number of fighters in the team.
+ * @return The new team.
+ * @throws std::invalid_argument If the team type is unknown.
+ */
+    std::unique_ptr<Team> createTeam(TeamType type, Character *leader, std::size_t capacity) {
+        switch (type) {
+            case TeamType::Team:
+                return std::make_unique<Team>(leader, capacity);
+            case TeamType::Team2:
+                return std::make_unique<Team2>(leader, capacity);
+            case TeamType::SmartTeam:
+                return std::make_unique<SmartTeam>(leader, capacity);
+            case TeamType::PackedTeam:
+                return std::make_unique<PackedTeam>(leader, capacity);
+        }
+        throw std::invalid_argument("Error: Unknown team type.");
+    }
+
+}
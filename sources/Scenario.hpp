@@ -0,0 +1,61 @@
+/**
+ * @file Scenario.hpp
+ * @brief Declarative description of a battle: two rosters and the team strategy each of them plays with.
+ * A scenario is plain data, so it can be shared read-only between the worker threads of the battle runner,
+ * each of which builds its own fighters and teams from it.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_SCENARIO_HPP
+#define COWBOY_VS_NINJA_B_SCENARIO_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Character.hpp"
+#include "FighterArena.hpp"
+#include "Team.hpp"
+#include "UnitStats.hpp"
+
+namespace ariel {
+
+    enum class TeamType : std::uint8_t {
+        Team,
+        Team2,
+        SmartTeam,
+        PackedTeam
+    };
+
+    struct FighterSpec {
+        UnitType type;
+        std::string name;
+        double x;
+        double y;
+    };
+
+    struct TeamSpec {
+        TeamType type;
+        // The first fighter of the roster is the team leader.
+        std::vector<FighterSpec> roster;
+    };
+
+    struct Scenario {
+        TeamSpec teamA;
+        TeamSpec teamB;
+        // Every fighter is displaced by up to this much on each axis, drawn from the battle seed.
+        double jitter = 0.0;
+        // A battle that is still undecided after this many rounds is scored as a draw.
+        int maxRounds = 1000;
+    };
+
+    Character *createFighter(const FighterSpec &spec, double offsetX = 0.0, double offsetY = 0.0);
+
+    Character *createFighter(const FighterSpec &spec, FighterArena &arena, double offsetX = 0.0, double offsetY = 0.0);
+
+    std::unique_ptr<Team> createTeam(TeamType type, Character *leader, std::size_t capacity = Team::MAX_FIGHTERS);
+
+}
+
+#endif //COWBOY_VS_NINJA_B_SCENARIO_HPP
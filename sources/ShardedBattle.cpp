@@ -0,0 +1,462 @@
+/**
+ * @file ShardedBattle.cpp
+ * @brief Implementation of the ShardedBattle class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "ShardedBattle.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "UnitStats.hpp"
+#include "Xoshiro256.hpp"
+
+namespace ariel {
+
+/**
+ * @brief Constructs a battle without fighters.
+ * @param threadCount The number of worker threads, 0 means one per hardware thread.
+ * @param mode How the damage reaches the victims.
+ * @param resolution How the two sides of a round take their turns.
+ */
+    ShardedBattle::ShardedBattle(std::size_t threadCount, DamageMode mode, Resolution resolution)
+            : pool(threadCount), mode(mode), resolution(resolution), aliveCounts{0, 0}, rounds(0) {
+        const std::size_t tiles = this->pool.size() * TILES_PER_THREAD;
+        this->tilesPerSide = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(tiles))));
+        this->ranges = tiles;
+        this->buffers.resize(this->tilesPerSide * this->tilesPerSide * this->ranges);
+        this->rangeKills.resize(this->ranges);
+        this->workerKills.resize(this->pool.size());
+    }
+
+/**
+ * @brief Copies the state of two teams into the battle, to play it without touching their Character objects.
+ * @param teamA The team taking the first turn of every round.
+ * @param teamB The other team.
+ */
+    void ShardedBattle::load(const Team &teamA, const Team &teamB) {
+        this->sides[0].load(teamA.getFighters());
+        this->sides[1].load(teamB.getFighters());
+        this->aliveCounts = {this->sides[0].countAlive(), this->sides[1].countAlive()};
+        this->kills[0].clear();
+        this->kills[1].clear();
+        this->rounds = 0;
+    }
+
+/**
+ * @brief Lays the rosters of a scenario out in the battle without building any Character, which is how battles
+ * of millions of fighters are loaded. The fighters are displaced exactly as BattleRunner::runBattle displaces them
+ * with the same seed, and start with the stats of their unit type.
+ * @param scenario The rosters, the team strategies are ignored.
+ * @param seed The seed used to displace the fighters by up to scenario.jitter.
+ * @throws std::invalid_argument If one of the rosters is empty.
+ */
+    void ShardedBattle::load(const Scenario &scenario, std::uint64_t seed) {
+        Xoshiro256 generator(seed);
+        const TeamSpec *specs[] = {&scenario.teamA, &scenario.teamB};
+        for (std::size_t side = 0; side < 2; side++) {
+            const std::vector<FighterSpec> &roster = specs[side]->roster;
+            if (roster.empty()) {
+                throw std::invalid_argument("Error: A team needs at least a leader.");
+            }
+            FighterStore &store = this->sides[side];
+            const std::size_t count = roster.size();
+            store.x.resize(count);
+            store.y.resize(count);
+            store.hitPoints.resize(count);
+            store.bullets.resize(count);
+            store.speed.resize(count);
+            store.kind.resize(count);
+            for (std::size_t slot = 0; slot < count; slot++) {
+                const FighterSpec &spec = roster[slot];
+                double offsetX = 0.0;
+                double offsetY = 0.0;
+                if (scenario.jitter > 0) {
+                    offsetX = generator.uniform(-scenario.jitter, scenario.jitter);
+                    offsetY = generator.uniform(-scenario.jitter, scenario.jitter);
+                }
+                const UnitStats &stats = statsOf(spec.type);
+                store.x[slot] = spec.x + offsetX;
+                store.y[slot] = spec.y + offsetY;
+                store.hitPoints[slot] = stats.hitPoints;
+                store.bullets[slot] = stats.magazine;
+                store.speed[slot] = stats.speed;
+                store.kind[slot] = spec.type == UnitType::Cowboy ? FighterKind::Cowboy : FighterKind::Ninja;
+            }
+        }
+        this->aliveCounts = {this->sides[0].size(), this->sides[1].size()};
+        this->kills[0].clear();
+        this->kills[1].clear();
+        this->rounds = 0;
+    }
+
+/**
+ * @brief Writes the state of the battle back to the Character objects of the teams it was loaded from.
+ * @param teamA The first team loaded.
+ * @param teamB The second team loaded.
+ * @throws std::invalid_argument If the rosters are not the size of the sides of the battle.
+ */
+    void ShardedBattle::publish(Team &teamA, Team &teamB) const {
+        if (teamA.getFighters().size() != this->sides[0].size() ||
+            teamB.getFighters().size() != this->sides[1].size()) {
+            throw std::invalid_argument("Error: The battle was loaded from other teams.");
+        }
+        this->sides[0].publish(teamA.getFighters());
+        this->sides[1].publish(teamB.getFighters());
+    }
+
+/**
+ * @brief Sorts the living fighters of the attacking side into square tiles of the box around them, keeping the
+ * slot order inside every tile.
+ * @param attackers The attacking side.
+ */
+    void ShardedBattle::sortIntoTiles(const FighterStore &attackers) {
+        const std::size_t count = attackers.size();
+        double lowX = 0;
+        double highX = 0;
+        double lowY = 0;
+        double highY = 0;
+        bool first = true;
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (attackers.isAlive(slot)) {
+                lowX = first ? attackers.x[slot] : std::min(lowX, attackers.x[slot]);
+                highX = first ? attackers.x[slot] : std::max(highX, attackers.x[slot]);
+                lowY = first ? attackers.y[slot] : std::min(lowY, attackers.y[slot]);
+                highY = first ? attackers.y[slot] : std::max(highY, attackers.y[slot]);
+                first = false;
+            }
+        }
+        const auto side = static_cast<double>(this->tilesPerSide);
+        const double tileWidth = (highX - lowX) / side + 1e-9;
+        const double tileHeight = (highY - lowY) / side + 1e-9;
+        auto tileIndex = [&](double coordinate, double low, double size) {
+            return std::min(this->tilesPerSide - 1, static_cast<std::size_t>((coordinate - low) / size));
+        };
+
+        // Counting sort by tile, the starts serving as the cursors and shifted back afterwards
+        this->tileOfSlot.assign(count, 0);
+        this->tileStart.assign(this->tilesPerSide * this->tilesPerSide + 1, 0);
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (attackers.isAlive(slot)) {
+                this->tileOfSlot[slot] = tileIndex(attackers.y[slot], lowY, tileHeight) * this->tilesPerSide +
+                                         tileIndex(attackers.x[slot], lowX, tileWidth);
+                this->tileStart[this->tileOfSlot[slot] + 1]++;
+            }
+        }
+        for (std::size_t tile = 0; tile + 1 < this->tileStart.size(); tile++) {
+            this->tileStart[tile + 1] += this->tileStart[tile];
+        }
+        this->tileSlots.resize(this->tileStart.back());
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (attackers.isAlive(slot)) {
+                this->tileSlots[this->tileStart[this->tileOfSlot[slot]]++] = slot;
+            }
+        }
+        for (std::size_t tile = this->tileStart.size() - 1; tile > 0; tile--) {
+            this->tileStart[tile] = this->tileStart[tile - 1];
+        }
+        this->tileStart[0] = 0;
+    }
+
+/**
+ * @brief Plays the fighters of a tile against the enemies as they were when the turn started. The damage is
+ * buffered by the tile, or subtracted atomically in the Atomic mode; the moves and the bullets are written to the
+ * slots of the fighters themselves.
+ * @param tile The tile.
+ * @param worker The worker playing the tile.
+ * @param attackers The attacking side.
+ * @param targets The defending side as the attackers see it, only read.
+ * @param victims The defending side taking the damage, whose hit points only change in the Atomic mode.
+ */
+    void ShardedBattle::attackTile(std::size_t tile, std::size_t worker, FighterStore &attackers,
+                                   const FighterStore &targets, FighterStore &victims) {
+        std::vector<Damage> *tileBuffers = &this->buffers[tile * this->ranges];
+        std::vector<std::size_t> &died = this->workerKills[worker];
+        const std::size_t victimCount = victims.size();
+        auto post = [&](std::size_t victim, int amount) {
+            if (this->mode == DamageMode::TileBuffers) {
+                tileBuffers[victim * this->ranges / victimCount].push_back(Damage{victim, amount});
+                return;
+            }
+            // Only one subtraction can take the hit points from above 0 to 0 or below
+            int before = std::atomic_ref<int>(victims.hitPoints[victim]).fetch_sub(amount, std::memory_order_relaxed);
+            if (before > 0 && before <= amount) {
+                died.push_back(victim);
+            }
+        };
+        for (std::size_t index = this->tileStart[tile]; index < this->tileStart[tile + 1]; index++) {
+            const std::size_t slot = this->tileSlots[index];
+            const std::size_t victim = this->enemies.nearest(attackers.x[slot], attackers.y[slot]);
+            if (victim == StaticGrid::npos) {
+                return;
+            }
+            if (attackers.kind[slot] == FighterKind::Cowboy) {
+                if (attackers.bullets[slot] > 0) {
+                    attackers.bullets[slot]--;
+                    post(victim, Cowboy::SHOT_DAMAGE);
+                } else {
+                    attackers.bullets[slot] = Cowboy::MAGAZINE_SIZE;
+                }
+                continue;
+            }
+            const double dx = targets.x[victim] - attackers.x[slot];
+            const double dy = targets.y[victim] - attackers.y[slot];
+            const double squared = dx * dx + dy * dy;
+            if (squared < Ninja::SLASH_RANGE * Ninja::SLASH_RANGE) {
+                post(victim, Ninja::SLASH_DAMAGE);
+                continue;
+            }
+            // The step of Point::moveTowards
+            const double distance = std::sqrt(squared);
+            const auto speed = static_cast<double>(attackers.speed[slot]);
+            if (distance <= speed) {
+                attackers.x[slot] = targets.x[victim];
+                attackers.y[slot] = targets.y[victim];
+            } else {
+                attackers.x[slot] += speed * dx / distance;
+                attackers.y[slot] += speed * dy / distance;
+            }
+        }
+    }
+
+/**
+ * @brief Applies the damage every tile dealt to a range of victims, tile after tile, and lists the victims that
+ * died. A victim stops taking damage once dead, so its hit points end at 0.
+ * @param range The range of victim slots.
+ * @param victims The defending side.
+ */
+    void ShardedBattle::mergeRange(std::size_t range, FighterStore &victims) {
+        std::vector<std::size_t> &died = this->rangeKills[range];
+        died.clear();
+        const std::size_t tiles = this->tilesPerSide * this->tilesPerSide;
+        for (std::size_t tile = 0; tile < tiles; tile++) {
+            std::vector<Damage> &buffer = this->buffers[tile * this->ranges + range];
+            for (const Damage &damage: buffer) {
+                int &hitPoints = victims.hitPoints[damage.victim];
+                if (hitPoints > 0) {
+                    hitPoints = std::max(0, hitPoints - damage.amount);
+                    if (hitPoints == 0) {
+                        died.push_back(damage.victim);
+                    }
+                }
+            }
+            buffer.clear();
+        }
+        std::sort(died.begin(), died.end());
+    }
+
+/**
+ * @brief A side strikes: its fighters living in a state act at once against the other side in a state, and the
+ * damage reaches the other side of the battle.
+ * @param side The attacking side.
+ * @param attackersSeen The attacking side as it was when the strike started, to pick the fighters that act.
+ * @param targets The defending side as it was when the strike started, to pick and reach the victims.
+ */
+    void ShardedBattle::strike(std::size_t side, const FighterStore &attackersSeen, const FighterStore &targets) {
+        FighterStore &attackers = this->sides[side];
+        FighterStore &victims = this->sides[1 - side];
+        std::vector<std::size_t> &died = this->kills[1 - side];
+        this->enemies.build(targets.x.data(), targets.y.data(), targets.hitPoints.data(), targets.size());
+        sortIntoTiles(attackersSeen);
+        this->pool.parallelFor(this->tilesPerSide * this->tilesPerSide, [&](std::size_t tile, std::size_t worker) {
+            attackTile(tile, worker, attackers, targets, victims);
+        });
+        if (this->mode == DamageMode::Atomic) {
+            // The killed went below 0 and take no more damage from the next turn on
+            for (std::vector<std::size_t> &workerDied: this->workerKills) {
+                died.insert(died.end(), workerDied.begin(), workerDied.end());
+                workerDied.clear();
+            }
+            std::sort(died.begin(), died.end());
+            for (std::size_t victim: died) {
+                victims.hitPoints[victim] = 0;
+            }
+        } else {
+            this->pool.parallelFor(this->ranges, [&](std::size_t range, std::size_t /*worker*/) {
+                mergeRange(range, victims);
+            });
+            for (const std::vector<std::size_t> &rangeDied: this->rangeKills) {
+                died.insert(died.end(), rangeDied.begin(), rangeDied.end());
+            }
+        }
+    }
+
+/**
+ * @brief The turn of a side: all its living fighters act at once against the other side.
+ * @param side 0 for team A attacking team B, 1 for team B attacking team A.
+ * @throws std::out_of_range If the side is neither 0 nor 1.
+ */
+    void ShardedBattle::turn(std::size_t side) {
+        if (side > 1) {
+            throw std::out_of_range("Error: A battle has two sides.");
+        }
+        this->kills[0].clear();
+        this->kills[1].clear();
+        if (this->aliveCounts[0] == 0 || this->aliveCounts[1] == 0) {
+            return;
+        }
+        strike(side, this->sides[side], this->sides[1 - side]);
+        this->aliveCounts[1 - side] -= this->kills[1 - side].size();
+    }
+
+/**
+ * @brief Plays a round under the resolution of the battle. In the Alternating resolution team A takes its turn,
+ * then team B if it still stands. In the Simultaneous resolution the state of both sides is copied to the round
+ * buffers first, both sides strike reading nothing but the buffers, and their moves and damage, written to the
+ * battle itself, are all committed together: a fighter killed during the round still strikes, and both sides may
+ * fall in the same round.
+ */
+    void ShardedBattle::round() {
+        if (this->resolution == Resolution::Alternating) {
+            turn(0);
+            std::vector<std::size_t> killedA = std::move(this->kills[0]);
+            if (this->aliveCounts[1] > 0) {
+                turn(1);
+            }
+            this->kills[0] = std::move(killedA);
+        } else {
+            this->kills[0].clear();
+            this->kills[1].clear();
+            if (this->aliveCounts[0] > 0 && this->aliveCounts[1] > 0) {
+                this->roundStart = this->sides;
+                strike(0, this->roundStart[0], this->roundStart[1]);
+                strike(1, this->roundStart[1], this->roundStart[0]);
+                this->aliveCounts[0] -= this->kills[0].size();
+                this->aliveCounts[1] -= this->kills[1].size();
+            }
+        }
+        this->rounds++;
+    }
+
+/**
+ * @brief Sums up the battle as it stands.
+ * @return The winner if a side was eliminated, the rounds played and the hit points left on each side.
+ */
+    BattleOutcome ShardedBattle::outcome() const {
+        auto survivingHitPoints = [](const FighterStore &store) {
+            int total = 0;
+            for (int points: store.hitPoints) {
+                total += points;
+            }
+            return total;
+        };
+        BattleOutcome result{BattleResult::Draw, this->rounds, survivingHitPoints(this->sides[0]),
+                             survivingHitPoints(this->sides[1])};
+        if (this->aliveCounts[0] > 0 && this->aliveCounts[1] == 0) {
+            result.result = BattleResult::TeamAWins;
+        } else if (this->aliveCounts[1] > 0 && this->aliveCounts[0] == 0) {
+            result.result = BattleResult::TeamBWins;
+        }
+        return result;
+    }
+
+/**
+ * @brief Plays rounds under the resolution of the battle, until a side is eliminated or a number of rounds was
+ * played.
+ * @param maxRounds The number of rounds after which the battle is a draw.
+ * @return The winner, the number of rounds played and the hit points left on each side.
+ */
+    BattleOutcome ShardedBattle::play(int maxRounds) {
+        while (this->rounds < maxRounds && this->aliveCounts[0] > 0 && this->aliveCounts[1] > 0) {
+            round();
+        }
+        return outcome();
+    }
+
+/**
+ * @brief Plays a whole battle between two teams under the rules of the mode and writes the result back to them.
+ * @param teamA The team taking the first turn of every round.
+ * @param teamB The other team.
+ * @param maxRounds The number of rounds after which the battle is a draw.
+ * @return The winner, the number of rounds played and the hit points left on each side.
+ */
+    BattleOutcome ShardedBattle::run(Team &teamA, Team &teamB, int maxRounds) {
+        load(teamA, teamB);
+        BattleOutcome result = play(maxRounds);
+        publish(teamA, teamB);
+        return result;
+    }
+
+/**
+ * @brief Getter for the state of a side.
+ * @param side 0 for team A, 1 for team B.
+ * @return The fighters of the side, in roster order.
+ * @throws std::out_of_range If the side is neither 0 nor 1.
+ */
+    const FighterStore &ShardedBattle::getSide(std::size_t side) const {
+        if (side > 1) {
+            throw std::out_of_range("Error: A battle has two sides.");
+        }
+        return this->sides[side];
+    }
+
+/**
+ * @brief Getter for the number of living fighters of a side.
+ * @param side 0 for team A, 1 for team B.
+ * @return The number of fighters with hit points left.
+ * @throws std::out_of_range If the side is neither 0 nor 1.
+ */
+    std::size_t ShardedBattle::stillAlive(std::size_t side) const {
+        if (side > 1) {
+            throw std::out_of_range("Error: A battle has two sides.");
+        }
+        return this->aliveCounts[side];
+    }
+
+/**
+ * @brief Getter for the fighters of a side killed during the last turn or round.
+ * @param side 0 for team A, 1 for team B.
+ * @return The slots of the killed in the side, in increasing order.
+ * @throws std::out_of_range If the side is neither 0 nor 1.
+ */
+    const std::vector<std::size_t> &ShardedBattle::getKills(std::size_t side) const {
+        if (side > 1) {
+            throw std::out_of_range("Error: A battle has two sides.");
+        }
+        return this->kills[side];
+    }
+
+/**
+ * @brief Getter for the number of rounds played since the battle was loaded.
+ * @return The number of rounds.
+ */
+    int ShardedBattle::getRounds() const {
+        return this->rounds;
+    }
+
+/**
+ * @brief Getter for the damage mode.
+ * @return How the damage reaches the victims.
+ */
+    ShardedBattle::DamageMode ShardedBattle::getDamageMode() const {
+        return this->mode;
+    }
+
+/**
+ * @brief Setter for the damage mode, which may change between turns.
+ * @param newMode How the damage reaches the victims.
+ */
+    void ShardedBattle::setDamageMode(DamageMode newMode) {
+        this->mode = newMode;
+    }
+
+/**
+ * @brief Getter for the resolution of the rounds.
+ * @return How the two sides of a round take their turns.
+ */
+    ShardedBattle::Resolution ShardedBattle::getResolution() const {
+        return this->resolution;
+    }
+
+/**
+ * @brief Setter for the resolution of the rounds, which may change between rounds.
+ * @param newResolution How the two sides of a round take their turns.
+ */
+    void ShardedBattle::setResolution(Resolution newResolution) {
+        this->resolution = newResolution;
+    }
+
+}
@@ -0,0 +1,135 @@
+/**
+ * @file ShardedBattle.hpp
+ * @brief Parallel simulation of a single battle between two huge rosters, on struct-of-arrays copies of them.
+ * The battle follows its own rule set, in which the fighters of a side act at once: during the turn of a side,
+ * every living fighter attacks the living enemy closest to itself when the turn started (the smallest slot among
+ * equidistant ones), a cowboy shooting it or reloading, a ninja slashing it or moving towards it. A fighter killed
+ * during the turn still takes the damage already aimed at it, and is out of the battle from the next turn on.
+ * By default team A takes its turn, then team B, every round, as in BattleRunner::fight.
+ *
+ * The field of the attacking side is cut into square tiles, and the tiles are played concurrently against a
+ * read-only StaticGrid of the enemies. The damage a tile deals is kept in buffers of its own, one per range of
+ * victim slots, and every range of victims is then merged by one worker, tile after tile. Since each fighter only
+ * writes to its own slot and the damage of a victim only depends on the sum aimed at it, the battle plays the same
+ * with any number of threads, and a battle loaded from a scenario depends on nothing but the scenario and the seed.
+ * In the Atomic damage mode the tiles subtract their damage from the hit points of the victims right away instead,
+ * with atomic fetch-subs; the worker whose subtraction takes a victim from above 0 to 0 or below records the kill,
+ * exactly once, and the kills are sorted afterwards. Both modes play the same battle.
+ *
+ * The Simultaneous resolution is the rule set in which no fighter sees the result of another one's action within a
+ * round: the state of both sides is copied to the round buffers, both sides act on the buffers only, and their
+ * moves and damage are committed together.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_SHARDEDBATTLE_HPP
+#define COWBOY_VS_NINJA_B_SHARDEDBATTLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BattleRunner.hpp"
+#include "FighterStore.hpp"
+#include "Scenario.hpp"
+#include "StaticGrid.hpp"
+#include "Team.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace ariel {
+
+    class ShardedBattle {
+    public:
+        // Tiles and victim ranges per worker thread, more than one so that stealing evens out crowded tiles.
+        static constexpr std::size_t TILES_PER_THREAD = 4;
+
+        // How the damage dealt concurrently during a turn reaches the hit points of the victims.
+        enum class DamageMode : std::uint8_t {
+            TileBuffers,
+            Atomic
+        };
+
+        // How the two sides of a round take their turns.
+        enum class Resolution : std::uint8_t {
+            Alternating,
+            Simultaneous
+        };
+
+        explicit ShardedBattle(std::size_t threadCount = 0, DamageMode mode = DamageMode::TileBuffers,
+                               Resolution resolution = Resolution::Alternating);
+
+        void load(const Team &teamA, const Team &teamB);
+
+        void load(const Scenario &scenario, std::uint64_t seed);
+
+        void publish(Team &teamA, Team &teamB) const;
+
+        void turn(std::size_t side);
+
+        void round();
+
+        BattleOutcome play(int maxRounds);
+
+        BattleOutcome run(Team &teamA, Team &teamB, int maxRounds);
+
+        const FighterStore &getSide(std::size_t side) const;
+
+        std::size_t stillAlive(std::size_t side) const;
+
+        const std::vector<std::size_t> &getKills(std::size_t side) const;
+
+        int getRounds() const;
+
+        DamageMode getDamageMode() const;
+
+        void setDamageMode(DamageMode newMode);
+
+        Resolution getResolution() const;
+
+        void setResolution(Resolution newResolution);
+
+    private:
+        struct Damage {
+            std::size_t victim;
+            int amount;
+        };
+
+        WorkStealingPool pool;
+        DamageMode mode;
+        Resolution resolution;
+        std::array<FighterStore, 2> sides;
+        // The state of both sides when a simultaneous round started, read by both sides during the round.
+        std::array<FighterStore, 2> roundStart;
+        std::array<std::size_t, 2> aliveCounts;
+        StaticGrid enemies;
+        std::size_t tilesPerSide;
+        std::size_t ranges;
+        // The living attackers of tile t, in slot order, are tileSlots[tileStart[t], tileStart[t + 1]).
+        std::vector<std::size_t> tileStart;
+        std::vector<std::size_t> tileSlots;
+        std::vector<std::size_t> tileOfSlot;
+        // buffers[tile * ranges + range] holds the damage the attackers of a tile dealt to a range of victims.
+        std::vector<std::vector<Damage>> buffers;
+        std::vector<std::vector<std::size_t>> rangeKills;
+        // The victims every worker killed in the Atomic mode, in no particular order.
+        std::vector<std::vector<std::size_t>> workerKills;
+        // The fighters of each side killed during the last turn or round, in slot order.
+        std::array<std::vector<std::size_t>, 2> kills;
+        int rounds;
+
+        void sortIntoTiles(const FighterStore &attackers);
+
+        void attackTile(std::size_t tile, std::size_t worker, FighterStore &attackers, const FighterStore &targets,
+                        FighterStore &victims);
+
+        void strike(std::size_t side, const FighterStore &attackersSeen, const FighterStore &targets);
+
+        void mergeRange(std::size_t range, FighterStore &victims);
+
+        BattleOutcome outcome() const;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_SHARDEDBATTLE_HPP
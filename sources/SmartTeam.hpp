@@ -1,6 +1,7 @@
 /**
  * @file SmartTeam.hpp
- * @brief Header file for the SmartTeam class .
+ * @brief Header file for the SmartTeam strategy.
+ * The fighters act in the order they joined the team and attack the enemy with the fewest hit points.
  * @author Tomer Gozlan
  * @date 17/05/2023
  */
@@ -10,30 +11,17 @@
 
 #include "Team.hpp"
 #include "Character.hpp"
+#include "StrategyTeam.hpp"
 
 namespace ariel {
-    class Attackers{
-    public:
-        bool operator()(Character* character1,Character* character2) const;
-    };
-
-    class Compare{
-    public:
-        bool operator()(Character* character1,Character* character2) const;
-    };
-
-    class SmartTeam : public Team{
 
+    class SmartTeam : public StrategyTeam<PriorityTargeting, RosterOrder> {
     public:
-        SmartTeam(Character* leader);
+        using StrategyTeam::StrategyTeam;
 
         Point askEnemyLocation(Character* enemy);
 
         int askEnemyHitPoints(Character* enemy);
-
-        void attack(Team *enemyTeam) override;
-
-        void print() override;
     };
 
 }
@@ -0,0 +1,427 @@
+/**
+ * @file SpatialGrid.cpp
+ * @brief Implementation of the SpatialGrid class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ariel {
+
+/**
+ * @brief Constructs an empty grid.
+ */
+    SpatialGrid::SpatialGrid() : minX(0), minY(0), cellSize(1), columns(0), rows(0), count(0), blockColumns(0),
+                                 blockRows(0), searchX(0), searchY(0), searchExcludedFirst(0),
+                                 searchExcludedLast(0), searchValid(false) {}
+
+/**
+ * @brief Replaces the content of the grid, sizing the cells so that there are about two points per cell.
+ * The bounds are padded around the points, so small moves don't force a rebuild.
+ * @param entries The points to index.
+ */
+    void SpatialGrid::build(const std::vector<Entry> &entries) {
+        this->cells.clear();
+        this->blockCounts.clear();
+        this->present.clear();
+        this->searchValid = false;
+        this->count = 0;
+        this->columns = 0;
+        this->rows = 0;
+        this->blockColumns = 0;
+        this->blockRows = 0;
+        if (entries.empty()) {
+            return;
+        }
+        double lowX = entries.front().x;
+        double highX = lowX;
+        double lowY = entries.front().y;
+        double highY = lowY;
+        for (const Entry &entry: entries) {
+            lowX = std::min(lowX, entry.x);
+            highX = std::max(highX, entry.x);
+            lowY = std::min(lowY, entry.y);
+            highY = std::max(highY, entry.y);
+        }
+        double padding = std::max(highX - lowX, highY - lowY) / 4 + 1;
+        this->minX = lowX - padding;
+        this->minY = lowY - padding;
+        double width = highX - lowX + 2 * padding;
+        double height = highY - lowY + 2 * padding;
+        double points = static_cast<double>(entries.size());
+        this->cellSize = std::max(std::sqrt(width * height * 2 / points), std::max(width, height) / points);
+        this->columns = static_cast<std::size_t>(width / this->cellSize) + 1;
+        this->rows = static_cast<std::size_t>(height / this->cellSize) + 1;
+        this->cells.resize(this->columns * this->rows);
+        this->blockColumns = (this->columns + BLOCK - 1) / BLOCK;
+        this->blockRows = (this->rows + BLOCK - 1) / BLOCK;
+        this->blockCounts.assign(this->blockColumns * this->blockRows, 0);
+        for (const Entry &entry: entries) {
+            this->cells[row(entry.y) * this->columns + column(entry.x)].push_back(entry);
+            this->blockCounts[block(column(entry.x), row(entry.y))]++;
+            markPresent(entry.slot);
+        }
+        this->count = entries.size();
+    }
+
+/**
+ * @brief Removes every point from the grid.
+ */
+    void SpatialGrid::clear() {
+        build({});
+    }
+
+/**
+ * @brief Getter for the number of indexed points.
+ * @return The number of points in the grid.
+ */
+    std::size_t SpatialGrid::size() const {
+        return this->count;
+    }
+
+/**
+ * @brief Checks if a location falls inside the bounds of the grid.
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @return True if the location maps to a cell without clamping.
+ */
+    bool SpatialGrid::contains(double x, double y) const {
+        return x >= this->minX && x < this->minX + static_cast<double>(this->columns) * this->cellSize &&
+               y >= this->minY && y < this->minY + static_cast<double>(this->rows) * this->cellSize;
+    }
+
+/**
+ * @brief Maps an x coordinate to a column, clamping locations outside of the grid to the border columns.
+ * @param x The x coordinate.
+ * @return The column index.
+ */
+    std::size_t SpatialGrid::column(double x) const {
+        double cell = std::floor((x - this->minX) / this->cellSize);
+        if (!(cell > 0)) {
+            return 0;
+        }
+        return std::min(this->columns - 1, static_cast<std::size_t>(cell));
+    }
+
+/**
+ * @brief Maps a y coordinate to a row, clamping locations outside of the grid to the border rows.
+ * @param y The y coordinate.
+ * @return The row index.
+ */
+    std::size_t SpatialGrid::row(double y) const {
+        double cell = std::floor((y - this->minY) / this->cellSize);
+        if (!(cell > 0)) {
+            return 0;
+        }
+        return std::min(this->rows - 1, static_cast<std::size_t>(cell));
+    }
+
+/**
+ * @brief Maps a cell to the block containing it.
+ * @param cellColumn The column of the cell.
+ * @param cellRow The row of the cell.
+ * @return The block index.
+ */
+    std::size_t SpatialGrid::block(std::size_t cellColumn, std::size_t cellRow) const {
+        return cellRow / BLOCK * this->blockColumns + cellColumn / BLOCK;
+    }
+
+/**
+ * @brief Records that the point of a slot is in the grid.
+ * @param slot The slot of the point.
+ */
+    void SpatialGrid::markPresent(std::size_t slot) {
+        if (slot >= this->present.size()) {
+            this->present.resize(slot + 1, false);
+        }
+        this->present[slot] = true;
+    }
+
+/**
+ * @brief Rebuilds the grid so that it also covers a location outside of its current bounds.
+ * @param x The x coordinate of the new point.
+ * @param y The y coordinate of the new point.
+ * @param slot The slot of the new point.
+ */
+    void SpatialGrid::rebuildAround(std::size_t slot, double x, double y) {
+        std::vector<Entry> entries;
+        entries.reserve(this->count + 1);
+        for (const std::vector<Entry> &cell: this->cells) {
+            entries.insert(entries.end(), cell.begin(), cell.end());
+        }
+        entries.push_back(Entry{slot, x, y});
+        build(entries);
+    }
+
+/**
+ * @brief Adds a point to the grid.
+ * @param slot The slot identifying the point.
+ * @param x The x coordinate of the point.
+ * @param y The y coordinate of the point.
+ */
+    void SpatialGrid::insert(std::size_t slot, double x, double y) {
+        if (this->cells.empty() || !contains(x, y)) {
+            rebuildAround(slot, x, y);
+            return;
+        }
+        this->cells[row(y) * this->columns + column(x)].push_back(Entry{slot, x, y});
+        this->blockCounts[block(column(x), row(y))]++;
+        markPresent(slot);
+        this->searchValid = false;
+        this->count++;
+    }
+
+/**
+ * @brief Removes a point from the grid, nothing happens if it isn't there.
+ * @param slot The slot identifying the point.
+ * @param x The x coordinate the point was indexed at.
+ * @param y The y coordinate the point was indexed at.
+ */
+    void SpatialGrid::erase(std::size_t slot, double x, double y) {
+        if (this->cells.empty()) {
+            return;
+        }
+        std::vector<Entry> &cell = this->cells[row(y) * this->columns + column(x)];
+        auto found = std::find_if(cell.begin(), cell.end(), [slot](const Entry &entry) { return entry.slot == slot; });
+        if (found != cell.end()) {
+            *found = cell.back();
+            cell.pop_back();
+            this->blockCounts[block(column(x), row(y))]--;
+            this->present[slot] = false;
+            this->count--;
+        }
+    }
+
+/**
+ * @brief Moves a point of the grid to a new location.
+ * @param slot The slot identifying the point.
+ * @param fromX The x coordinate the point was indexed at.
+ * @param fromY The y coordinate the point was indexed at.
+ * @param toX The new x coordinate.
+ * @param toY The new y coordinate.
+ */
+    void SpatialGrid::move(std::size_t slot, double fromX, double fromY, double toX, double toY) {
+        std::size_t before = this->count;
+        erase(slot, fromX, fromY);
+        if (this->count != before) {
+            insert(slot, toX, toY);
+        }
+    }
+
+/**
+ * @brief A lower bound of the squared distance from a location to the points of a square of cells.
+ * Cell bounds are only approximately where column() and row() split the plane, so the square is widened by a
+ * tiny fraction of a cell on every side.
+ * @param firstColumn The left column of the square.
+ * @param firstRow The bottom row of the square.
+ * @param span The number of cells on each side of the square.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The lower bound of the squared distance.
+ */
+    double SpatialGrid::gap(std::size_t firstColumn, std::size_t firstRow, std::size_t span, double x,
+                            double y) const {
+        double left = this->minX + static_cast<double>(firstColumn) * this->cellSize;
+        double bottom = this->minY + static_cast<double>(firstRow) * this->cellSize;
+        double side = static_cast<double>(span) * this->cellSize;
+        double slack = this->cellSize * 1e-9;
+        double gapX = std::max(std::max(left - x - slack, 0.0), x - (left + side) - slack);
+        double gapY = std::max(std::max(bottom - y - slack, 0.0), y - (bottom + side) - slack);
+        return gapX * gapX + gapY * gapY;
+    }
+
+/**
+ * @brief The order of the search frontier: by key, rings before blocks, blocks before cells and cells before points
+ * of the same key, and points of the same distance in slot order. Since a ring, block or cell comes before a point
+ * of the same key, a point is only taken once every area that may hold a point as close as it has been opened.
+ * @param first A candidate.
+ * @param second Another candidate.
+ * @return True if first is searched after second.
+ */
+    bool SpatialGrid::later(const Candidate &first, const Candidate &second) {
+        if (first.key != second.key) {
+            return first.key > second.key;
+        }
+        if (first.level != second.level) {
+            return first.level > second.level;
+        }
+        return first.id > second.id;
+    }
+
+/**
+ * @brief Adds a candidate to the search frontier, a min-heap in the order of later().
+ * @param key The lower bound of the squared distance of the candidate, its exact squared distance for a point.
+ * @param level Whether the candidate is a ring, a block, a cell or a point.
+ * @param id The distance of the ring, the index of the block or cell, the slot of the point.
+ */
+    void SpatialGrid::push(double key, Level level, std::size_t id) const {
+        this->frontier.push_back(Candidate{key, level, id});
+        std::push_heap(this->frontier.begin(), this->frontier.end(), later);
+    }
+
+/**
+ * @brief A lower bound of the squared distance from the searched location to the blocks of a ring around its
+ * block. Moving a block towards the block of the location on one axis brings it no farther, so the closest block
+ * of a ring is one straight along an axis from the block of the location.
+ * @param ring The distance in blocks, on the farthest axis, from the block of the location.
+ * @return The lower bound, infinity if the ring is outside of the grid.
+ */
+    double SpatialGrid::ringGap(std::size_t ring) const {
+        const std::size_t centerColumn = column(this->searchX) / BLOCK;
+        const std::size_t centerRow = row(this->searchY) / BLOCK;
+        double lowest = std::numeric_limits<double>::infinity();
+        auto consider = [&](std::size_t blockColumn, std::size_t blockRow) {
+            lowest = std::min(lowest, gap(blockColumn * BLOCK, blockRow * BLOCK, BLOCK, this->searchX, this->searchY));
+        };
+        if (ring <= centerColumn) {
+            consider(centerColumn - ring, centerRow);
+        }
+        if (centerColumn + ring < this->blockColumns) {
+            consider(centerColumn + ring, centerRow);
+        }
+        if (ring <= centerRow) {
+            consider(centerColumn, centerRow - ring);
+        }
+        if (centerRow + ring < this->blockRows) {
+            consider(centerColumn, centerRow + ring);
+        }
+        return lowest;
+    }
+
+/**
+ * @brief Adds the non-empty blocks of a ring around the block of the searched location to the search frontier,
+ * and the next ring if it is still inside the grid.
+ * @param ring The distance in blocks, on the farthest axis, from the block of the location.
+ */
+    void SpatialGrid::openRing(std::size_t ring) const {
+        const auto centerColumn = static_cast<std::ptrdiff_t>(column(this->searchX) / BLOCK);
+        const auto centerRow = static_cast<std::ptrdiff_t>(row(this->searchY) / BLOCK);
+        const auto lastColumn = static_cast<std::ptrdiff_t>(this->blockColumns) - 1;
+        const auto lastRow = static_cast<std::ptrdiff_t>(this->blockRows) - 1;
+        const auto distance = static_cast<std::ptrdiff_t>(ring);
+        auto open = [&](std::ptrdiff_t blockColumn, std::ptrdiff_t blockRow) {
+            auto index = static_cast<std::size_t>(blockRow * (lastColumn + 1) + blockColumn);
+            if (this->blockCounts[index] > 0) {
+                push(gap(static_cast<std::size_t>(blockColumn) * BLOCK, static_cast<std::size_t>(blockRow) * BLOCK,
+                         BLOCK, this->searchX, this->searchY), Level::Block, index);
+            }
+        };
+        if (ring == 0) {
+            open(centerColumn, centerRow);
+        } else {
+            // The bottom and top rows of the ring, then its left and right columns between them
+            const std::ptrdiff_t firstColumn = std::max<std::ptrdiff_t>(centerColumn - distance, 0);
+            const std::ptrdiff_t endColumn = std::min(centerColumn + distance, lastColumn) + 1;
+            const std::ptrdiff_t firstRow = std::max<std::ptrdiff_t>(centerRow - distance + 1, 0);
+            const std::ptrdiff_t endRow = std::min(centerRow + distance - 1, lastRow) + 1;
+            for (std::ptrdiff_t blockColumn = firstColumn; blockColumn < endColumn; blockColumn++) {
+                if (centerRow - distance >= 0) {
+                    open(blockColumn, centerRow - distance);
+                }
+                if (centerRow + distance <= lastRow) {
+                    open(blockColumn, centerRow + distance);
+                }
+            }
+            for (std::ptrdiff_t blockRow = firstRow; blockRow < endRow; blockRow++) {
+                if (centerColumn - distance >= 0) {
+                    open(centerColumn - distance, blockRow);
+                }
+                if (centerColumn + distance <= lastColumn) {
+                    open(centerColumn + distance, blockRow);
+                }
+            }
+        }
+        double next = ringGap(ring + 1);
+        if (next != std::numeric_limits<double>::infinity()) {
+            push(next, Level::Ring, ring + 1);
+        }
+    }
+
+/**
+ * @brief Starts a new search from a location, seeding the frontier with the block containing it; the blocks
+ * around it are opened ring after ring, each ring when the search gets as far as it.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @param excludedFirst The first slot left out.
+ * @param excludedLast The slot past the last one left out.
+ */
+    void SpatialGrid::startSearch(double x, double y, std::size_t excludedFirst, std::size_t excludedLast) const {
+        this->frontier.clear();
+        this->searchX = x;
+        this->searchY = y;
+        this->searchExcludedFirst = excludedFirst;
+        this->searchExcludedLast = excludedLast;
+        this->searchValid = true;
+        openRing(0);
+    }
+
+/**
+ * @brief Finds the point closest to a location with a best-first search over rings of blocks, blocks, cells and
+ * points. Points are ordered by Point::distanceSquared and ties go to the smallest slot, so the answer is the
+ * one a linear scan in slot order would give. The search is resumed when the location is the same as in the
+ * previous call and no point was inserted or moved since, the points erased in between being skipped.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The slot of the closest point, npos if the grid is empty.
+ */
+    std::size_t SpatialGrid::nearest(double x, double y) const {
+        return nearest(x, y, 0, 0);
+    }
+
+/**
+ * @brief Finds the point closest to a location among the points whose slot is outside a range, e.g. the nearest
+ * enemy when the rosters of all teams share the grid. The points of the range popped by the search are dropped
+ * from it, so the search is resumed only by a query leaving out the same range.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @param excludedFirst The first slot left out.
+ * @param excludedLast The slot past the last one left out, excludedFirst to leave out nothing.
+ * @return The slot of the closest point outside the range, npos if there is none.
+ */
+    std::size_t SpatialGrid::nearest(double x, double y, std::size_t excludedFirst, std::size_t excludedLast) const {
+        if (this->count == 0) {
+            return npos;
+        }
+        if (!this->searchValid || x != this->searchX || y != this->searchY ||
+            excludedFirst != this->searchExcludedFirst || excludedLast != this->searchExcludedLast) {
+            startSearch(x, y, excludedFirst, excludedLast);
+        }
+        while (!this->frontier.empty()) {
+            Candidate top = this->frontier.front();
+            if (top.level == Level::Point && this->present[top.id] &&
+                (top.id < excludedFirst || top.id >= excludedLast)) {
+                return top.id;
+            }
+            std::pop_heap(this->frontier.begin(), this->frontier.end(), later);
+            this->frontier.pop_back();
+            if (top.level == Level::Ring) {
+                openRing(top.id);
+            } else if (top.level == Level::Block) {
+                const std::size_t firstColumn = top.id % this->blockColumns * BLOCK;
+                const std::size_t firstRow = top.id / this->blockColumns * BLOCK;
+                const std::size_t endColumn = std::min(this->columns, firstColumn + BLOCK);
+                const std::size_t endRow = std::min(this->rows, firstRow + BLOCK);
+                for (std::size_t cellRow = firstRow; cellRow < endRow; cellRow++) {
+                    for (std::size_t cellColumn = firstColumn; cellColumn < endColumn; cellColumn++) {
+                        std::size_t index = cellRow * this->columns + cellColumn;
+                        if (!this->cells[index].empty()) {
+                            push(gap(cellColumn, cellRow, 1, x, y), Level::Cell, index);
+                        }
+                    }
+                }
+            } else if (top.level == Level::Cell) {
+                for (const Entry &entry: this->cells[top.id]) {
+                    double dx = x - entry.x;
+                    double dy = y - entry.y;
+                    push(dx * dx + dy * dy, Level::Point, entry.slot);
+                }
+            }
+        }
+        return npos;
+    }
+
+}
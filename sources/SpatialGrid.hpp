@@ -0,0 +1,123 @@
+/**
+ * @file SpatialGrid.hpp
+ * @brief A uniform grid over 2D points, answering nearest-point queries without scanning every point.
+ * Points are identified by their slot in a roster and can be inserted, erased and moved one at a time.
+ * The grid grows its bounds when a point leaves them, so it can follow fighters across the board.
+ * Nearest-point queries are best-first searches whose state is kept between calls: while the same location is
+ * queried and points are only erased, as when a team keeps shooting at whoever is closest to its leader,
+ * every query resumes where the previous one stopped instead of searching the emptied area again. A search opens
+ * the blocks of cells around the location ring after ring, so it only visits the part of the grid closer than
+ * the answer.
+ * A query can leave out a range of slots, so points of several rosters can share one grid, each roster holding a
+ * contiguous range of slots and looking for the nearest point of the others.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_SPATIALGRID_HPP
+#define COWBOY_VS_NINJA_B_SPATIALGRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ariel {
+
+    class SpatialGrid {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        struct Entry {
+            std::size_t slot;
+            double x;
+            double y;
+        };
+
+        SpatialGrid();
+
+        void build(const std::vector<Entry> &entries);
+
+        void clear();
+
+        std::size_t size() const;
+
+        void insert(std::size_t slot, double x, double y);
+
+        void erase(std::size_t slot, double x, double y);
+
+        void move(std::size_t slot, double fromX, double fromY, double toX, double toY);
+
+        std::size_t nearest(double x, double y) const;
+
+        std::size_t nearest(double x, double y, std::size_t excludedFirst, std::size_t excludedLast) const;
+
+    private:
+        // Cells are grouped in square blocks of this many cells per side, a search opens them ring after ring.
+        static constexpr std::size_t BLOCK = 8;
+
+        enum class Level : std::uint8_t {
+            Ring,
+            Block,
+            Cell,
+            Point
+        };
+
+        // A ring of blocks, block, cell or point waiting in the search frontier, key being a lower bound of its
+        // distance. The id of a ring is its distance in blocks from the block of the location.
+        struct Candidate {
+            double key;
+            Level level;
+            std::size_t id;
+        };
+
+        double minX;
+        double minY;
+        double cellSize;
+        std::size_t columns;
+        std::size_t rows;
+        std::size_t count;
+        std::vector<std::vector<Entry>> cells;
+        std::size_t blockColumns;
+        std::size_t blockRows;
+        // The number of points in each block.
+        std::vector<std::size_t> blockCounts;
+        // Indexed by slot, true while the point of the slot is in the grid.
+        std::vector<bool> present;
+
+        // The search of the last nearest() call, valid until a point is inserted or moved.
+        mutable std::vector<Candidate> frontier;
+        mutable double searchX;
+        mutable double searchY;
+        mutable std::size_t searchExcludedFirst;
+        mutable std::size_t searchExcludedLast;
+        mutable bool searchValid;
+
+        bool contains(double x, double y) const;
+
+        std::size_t column(double x) const;
+
+        std::size_t row(double y) const;
+
+        std::size_t block(std::size_t cellColumn, std::size_t cellRow) const;
+
+        void rebuildAround(std::size_t slot, double x, double y);
+
+        void markPresent(std::size_t slot);
+
+        double gap(std::size_t firstColumn, std::size_t firstRow, std::size_t span, double x, double y) const;
+
+        double ringGap(std::size_t ring) const;
+
+        void openRing(std::size_t ring) const;
+
+        static bool later(const Candidate &first, const Candidate &second);
+
+        void push(double key, Level level, std::size_t id) const;
+
+        void startSearch(double x, double y, std::size_t excludedFirst, std::size_t excludedLast) const;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_SPATIALGRID_HPP
@@ -0,0 +1,270 @@
+/**
+ * @file StaticGrid.cpp
+ * @brief Implementation of the StaticGrid class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "StaticGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ariel {
+
+/**
+ * @brief Constructs an empty grid.
+ */
+    StaticGrid::StaticGrid() : minX(0), minY(0), cellSize(1), columns(0), rows(0) {}
+
+/**
+ * @brief Indexes the living points of packed arrays, replacing the previous content. The cells are sized so that
+ * there are about two points per cell, and the memory of the previous build is reused.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param hitPoints The hit points, a point is indexed when they are above 0.
+ * @param count The number of points in the arrays.
+ */
+    void StaticGrid::build(const double *xs, const double *ys, const int *hitPoints, std::size_t count) {
+        this->columns = 0;
+        this->rows = 0;
+        this->slots.clear();
+        this->packedX.clear();
+        this->packedY.clear();
+        this->cellStart.assign(1, 0);
+        std::size_t living = 0;
+        double lowX = 0;
+        double highX = 0;
+        double lowY = 0;
+        double highY = 0;
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (hitPoints[slot] > 0) {
+                lowX = living == 0 ? xs[slot] : std::min(lowX, xs[slot]);
+                highX = living == 0 ? xs[slot] : std::max(highX, xs[slot]);
+                lowY = living == 0 ? ys[slot] : std::min(lowY, ys[slot]);
+                highY = living == 0 ? ys[slot] : std::max(highY, ys[slot]);
+                living++;
+            }
+        }
+        if (living == 0) {
+            return;
+        }
+        this->minX = lowX;
+        this->minY = lowY;
+        double width = highX - lowX + 1;
+        double height = highY - lowY + 1;
+        double points = static_cast<double>(living);
+        this->cellSize = std::max(std::sqrt(width * height * 2 / points), std::max(width, height) / points);
+        this->columns = static_cast<std::size_t>(width / this->cellSize) + 1;
+        this->rows = static_cast<std::size_t>(height / this->cellSize) + 1;
+
+        // Counting sort of the living points by cell, stable so every cell lists its points in slot order
+        this->cellOfSlot.assign(count, npos);
+        this->cellStart.assign(this->columns * this->rows + 1, 0);
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (hitPoints[slot] > 0) {
+                this->cellOfSlot[slot] = row(ys[slot]) * this->columns + column(xs[slot]);
+                this->cellStart[this->cellOfSlot[slot] + 1]++;
+            }
+        }
+        for (std::size_t cell = 0; cell + 1 < this->cellStart.size(); cell++) {
+            this->cellStart[cell + 1] += this->cellStart[cell];
+        }
+        this->slots.resize(living);
+        this->packedX.resize(living);
+        this->packedY.resize(living);
+        // The starts serve as the cursors of the cells, which leaves every start at the end of its cell
+        for (std::size_t slot = 0; slot < count; slot++) {
+            if (this->cellOfSlot[slot] != npos) {
+                std::size_t index = this->cellStart[this->cellOfSlot[slot]]++;
+                this->slots[index] = slot;
+                this->packedX[index] = xs[slot];
+                this->packedY[index] = ys[slot];
+            }
+        }
+        for (std::size_t cell = this->cellStart.size() - 1; cell > 0; cell--) {
+            this->cellStart[cell] = this->cellStart[cell - 1];
+        }
+        this->cellStart[0] = 0;
+    }
+
+/**
+ * @brief Getter for the number of points indexed.
+ * @return The number of living points of the last build.
+ */
+    std::size_t StaticGrid::size() const {
+        return this->slots.size();
+    }
+
+/**
+ * @brief Maps an x coordinate to a column, clamping locations outside of the grid to the border columns.
+ * @param x The x coordinate.
+ * @return The column.
+ */
+    std::size_t StaticGrid::column(double x) const {
+        double cell = std::floor((x - this->minX) / this->cellSize);
+        if (!(cell > 0)) {
+            return 0;
+        }
+        return std::min(this->columns - 1, static_cast<std::size_t>(cell));
+    }
+
+/**
+ * @brief Maps a y coordinate to a row, clamping locations outside of the grid to the border rows.
+ * @param y The y coordinate.
+ * @return The row.
+ */
+    std::size_t StaticGrid::row(double y) const {
+        double cell = std::floor((y - this->minY) / this->cellSize);
+        if (!(cell > 0)) {
+            return 0;
+        }
+        return std::min(this->rows - 1, static_cast<std::size_t>(cell));
+    }
+
+/**
+ * @brief A lower bound of the squared distance from a location to the points of a rectangle of cells, clipped to
+ * the grid. Every point lies inside the cells it was sorted into, and the rectangle is widened by a tiny fraction
+ * of a cell on every side, like the squares of SpatialGrid.
+ * @param firstColumn The left column.
+ * @param lastColumn The right column.
+ * @param firstRow The bottom row.
+ * @param lastRow The top row.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The lower bound, infinity if the rectangle is outside of the grid.
+ */
+    double StaticGrid::gap(std::ptrdiff_t firstColumn, std::ptrdiff_t lastColumn, std::ptrdiff_t firstRow,
+                           std::ptrdiff_t lastRow, double x, double y) const {
+        firstColumn = std::max<std::ptrdiff_t>(firstColumn, 0);
+        lastColumn = std::min(lastColumn, static_cast<std::ptrdiff_t>(this->columns) - 1);
+        firstRow = std::max<std::ptrdiff_t>(firstRow, 0);
+        lastRow = std::min(lastRow, static_cast<std::ptrdiff_t>(this->rows) - 1);
+        if (firstColumn > lastColumn || firstRow > lastRow) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const double slack = this->cellSize * 1e-9;
+        double left = this->minX + static_cast<double>(firstColumn) * this->cellSize;
+        double right = this->minX + static_cast<double>(lastColumn + 1) * this->cellSize;
+        double bottom = this->minY + static_cast<double>(firstRow) * this->cellSize;
+        double top = this->minY + static_cast<double>(lastRow + 1) * this->cellSize;
+        double gapX = std::max(std::max(left - x - slack, 0.0), x - right - slack);
+        double gapY = std::max(std::max(bottom - y - slack, 0.0), y - top - slack);
+        return gapX * gapX + gapY * gapY;
+    }
+
+/**
+ * @brief The cells of a line of the grid that a disc can reach, a line being a row or a column.
+ * @param center The coordinate of the center of the disc along the line.
+ * @param origin The coordinate of the first cell of the line.
+ * @param across The distance from the center of the disc to the line, across it.
+ * @param squaredRadius The squared radius of the disc, infinity for the whole line.
+ * @param first The first cell of the range searched.
+ * @param last The last cell of the range searched.
+ * @return The first and last cells of the range within the disc, first > last if none is.
+ */
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> StaticGrid::reach(double center, double origin, double across,
+                                                                double squaredRadius, std::ptrdiff_t first,
+                                                                std::ptrdiff_t last) const {
+        const double remaining = squaredRadius - across * across;
+        if (remaining < 0) {
+            return {first, first - 1};
+        }
+        // The cells of the ends of the chord by the formula that sorted the points, the chord widened by a tiny
+        // fraction of a cell so that the points exactly as far as the radius are kept
+        const double radius = std::sqrt(remaining) + this->cellSize * 1e-9;
+        const double low = std::floor((center - radius - origin) / this->cellSize);
+        const double high = std::floor((center + radius - origin) / this->cellSize);
+        const auto firstCell = static_cast<double>(first);
+        const auto lastCell = static_cast<double>(last);
+        return {static_cast<std::ptrdiff_t>(std::clamp(low, firstCell, lastCell + 1)),
+                static_cast<std::ptrdiff_t>(std::clamp(high, firstCell - 1, lastCell))};
+    }
+
+/**
+ * @brief Finds the point closest to a location by searching rings of cells around its cell, until the next ring
+ * is farther than the closest point found. A location outside of the grid starts from the closest border cell.
+ * Of several points at the same squared distance the smallest slot wins, as with a linear scan in slot order.
+ * The grid is not modified, so threads may search it concurrently.
+ * @param x The x coordinate of the location.
+ * @param y The y coordinate of the location.
+ * @return The slot of the closest point, npos if the grid is empty.
+ */
+    std::size_t StaticGrid::nearest(double x, double y) const {
+        if (this->slots.empty()) {
+            return npos;
+        }
+        const auto centerColumn = static_cast<std::ptrdiff_t>(column(x));
+        const auto centerRow = static_cast<std::ptrdiff_t>(row(y));
+        const auto lastColumn = static_cast<std::ptrdiff_t>(this->columns) - 1;
+        const auto lastRow = static_cast<std::ptrdiff_t>(this->rows) - 1;
+        double best = std::numeric_limits<double>::infinity();
+        std::size_t bestSlot = npos;
+        auto scan = [&](std::ptrdiff_t cellColumn, std::ptrdiff_t cellRow) {
+            std::size_t cell = static_cast<std::size_t>(cellRow) * this->columns + static_cast<std::size_t>(cellColumn);
+            for (std::size_t index = this->cellStart[cell]; index < this->cellStart[cell + 1]; index++) {
+                double dx = this->packedX[index] - x;
+                double dy = this->packedY[index] - y;
+                double squared = dx * dx + dy * dy;
+                if (squared < best || (squared == best && this->slots[index] < bestSlot)) {
+                    best = squared;
+                    bestSlot = this->slots[index];
+                }
+            }
+        };
+        scan(centerColumn, centerRow);
+        for (std::ptrdiff_t ring = 1;; ring++) {
+            const std::ptrdiff_t left = centerColumn - ring;
+            const std::ptrdiff_t right = centerColumn + ring;
+            const std::ptrdiff_t bottom = centerRow - ring;
+            const std::ptrdiff_t top = centerRow + ring;
+            if (left < 0 && right > lastColumn && bottom < 0 && top > lastRow) {
+                break;
+            }
+            // The ring is its bottom and top rows, then its left and right columns between them
+            double lowerBound = std::min(std::min(gap(left, right, bottom, bottom, x, y),
+                                                  gap(left, right, top, top, x, y)),
+                                         std::min(gap(left, left, bottom + 1, top - 1, x, y),
+                                                  gap(right, right, bottom + 1, top - 1, x, y)));
+            if (lowerBound > best) {
+                break;
+            }
+            // Only the cells of the ring within the distance of the closest point found so far are scanned
+            const std::ptrdiff_t firstColumn = std::max<std::ptrdiff_t>(left, 0);
+            const std::ptrdiff_t endColumn = std::min(right, lastColumn);
+            const std::ptrdiff_t firstRow = std::max<std::ptrdiff_t>(bottom + 1, 0);
+            const std::ptrdiff_t endRow = std::min(top - 1, lastRow);
+            const double slack = this->cellSize * 1e-9;
+            auto scanRow = [&](std::ptrdiff_t cellRow) {
+                double low = this->minY + static_cast<double>(cellRow) * this->cellSize;
+                double across = std::max(std::max(low - y - slack, 0.0), y - low - this->cellSize - slack);
+                auto [first, last] = reach(x, this->minX, across, best, firstColumn, endColumn);
+                for (std::ptrdiff_t cellColumn = first; cellColumn <= last; cellColumn++) {
+                    scan(cellColumn, cellRow);
+                }
+            };
+            auto scanColumn = [&](std::ptrdiff_t cellColumn) {
+                double low = this->minX + static_cast<double>(cellColumn) * this->cellSize;
+                double across = std::max(std::max(low - x - slack, 0.0), x - low - this->cellSize - slack);
+                auto [first, last] = reach(y, this->minY, across, best, firstRow, endRow);
+                for (std::ptrdiff_t cellRow = first; cellRow <= last; cellRow++) {
+                    scan(cellColumn, cellRow);
+                }
+            };
+            if (bottom >= 0) {
+                scanRow(bottom);
+            }
+            if (top <= lastRow) {
+                scanRow(top);
+            }
+            if (left >= 0) {
+                scanColumn(left);
+            }
+            if (right <= lastColumn) {
+                scanColumn(right);
+            }
+        }
+        return bestSlot;
+    }
+
+}
@@ -0,0 +1,61 @@
+/**
+ * @file StaticGrid.hpp
+ * @brief A uniform grid over the living fighters of a roster, built in one pass and read-only afterwards.
+ * The points are sorted into their cells with a counting sort, so every cell is a contiguous range of packed
+ * coordinates. Unlike SpatialGrid, a query keeps no state, so any number of threads can search the grid at once;
+ * the grid is rebuilt, not updated, when the fighters move or die.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_STATICGRID_HPP
+#define COWBOY_VS_NINJA_B_STATICGRID_HPP
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ariel {
+
+    class StaticGrid {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        StaticGrid();
+
+        void build(const double *xs, const double *ys, const int *hitPoints, std::size_t count);
+
+        std::size_t size() const;
+
+        std::size_t nearest(double x, double y) const;
+
+    private:
+        double minX;
+        double minY;
+        double cellSize;
+        std::size_t columns;
+        std::size_t rows;
+        // The points of cell i are at [cellStart[i], cellStart[i + 1]) of the packed arrays, in slot order.
+        std::vector<std::size_t> cellStart;
+        std::vector<std::size_t> slots;
+        std::vector<double> packedX;
+        std::vector<double> packedY;
+        // Reused by build() for the cell of every slot, npos for the dead.
+        std::vector<std::size_t> cellOfSlot;
+
+        std::size_t column(double x) const;
+
+        std::size_t row(double y) const;
+
+        double gap(std::ptrdiff_t firstColumn, std::ptrdiff_t lastColumn, std::ptrdiff_t firstRow,
+                   std::ptrdiff_t lastRow, double x, double y) const;
+
+        std::pair<std::ptrdiff_t, std::ptrdiff_t> reach(double center, double origin, double across,
+                                                        double squaredRadius, std::ptrdiff_t first,
+                                                        std::ptrdiff_t last) const;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_STATICGRID_HPP
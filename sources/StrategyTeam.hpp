@@ -0,0 +1,154 @@
+/**
+ * @file StrategyTeam.hpp
+ * @brief A team engine parameterised on compile-time strategy policies: which enemy the fighters attack and in
+ * which order the fighters act. The validation, leader replacement, victim retargeting and end of battle checks
+ * are shared by every strategy, and the policies are plain types the compiler inlines into the attack loop, so
+ * a new strategy costs no runtime dispatch beyond the virtual tryAttack itself.
+ *
+ * A Targeting policy is default-constructible and provides
+ *     Character *first(const Team &team, Team *enemyTeam)  the victim at the start of an attack,
+ *     Character *next(const Team &team, Team *enemyTeam)   the victim after the previous one died;
+ * both return a living enemy, the enemy team having some.
+ * An Order policy provides
+ *     template <class Visit> static bool forEach(const Team &team, Visit &&visit)
+ * calling visit(slot) for the living fighters of the team in the order they act, stopping when visit returns false.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_STRATEGYTEAM_HPP
+#define COWBOY_VS_NINJA_B_STRATEGYTEAM_HPP
+
+#include <cstddef>
+#include <string>
+#include "Team.hpp"
+#include "TargetHeap.hpp"
+
+namespace ariel {
+
+    // Attacks the living enemy closest to the leader of the attacking team.
+    class NearestTargeting {
+    public:
+        Character *first(const Team &team, Team *enemyTeam) {
+            return enemyTeam->closestAlive(team.getLeader()->getLocation());
+        }
+
+        Character *next(const Team &team, Team *enemyTeam) {
+            return first(team, enemyTeam);
+        }
+    };
+
+    // Attacks the living enemy with the fewest hit points, cowboys before ninjas, then the enemy that joined first.
+    // The enemies are kept in a TargetHeap that follows the enemy team across turns.
+    class PriorityTargeting {
+    private:
+        TargetHeap targets;
+
+    public:
+        Character *first(const Team & /*team*/, Team *enemyTeam) {
+            if (this->targets.getWatched() != enemyTeam) {
+                this->targets.watch(enemyTeam);
+            }
+            return this->targets.top();
+        }
+
+        Character *next(const Team & /*team*/, Team * /*enemyTeam*/) {
+            return this->targets.top();
+        }
+    };
+
+    // The fighters act in the order they joined the team.
+    class RosterOrder {
+    public:
+        template<class Visit>
+        static bool forEach(const Team &team, Visit &&visit) {
+            for (std::size_t slot: team.getLiveSlots()) {
+                if (!visit(slot)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // The cowboys act first, then the ninjas, each in the order they joined the team.
+    class CowboysFirst {
+    public:
+        template<class Visit>
+        static bool forEach(const Team &team, Visit &&visit) {
+            for (FighterKind phase: {FighterKind::Cowboy, FighterKind::Ninja}) {
+                for (std::size_t slot: team.getLiveSlots()) {
+                    if (team.getFighters()[slot]->getKind() == phase && !visit(slot)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    template<class Targeting, class Order>
+    class StrategyTeam : public Team {
+    private:
+        Targeting targeting;
+
+    public:
+        explicit StrategyTeam(Character *leader) : Team(leader) {}
+
+        StrategyTeam(Character *leader, std::size_t capacity) : Team(leader, capacity) {}
+
+        /**
+         * @brief Attacks the enemy team, reporting a rejection as a status: every living fighter, in the order of
+         * the Order policy, acts against the victim of the Targeting policy, which is replaced as soon as it dies.
+         * A dead leader of either team is replaced by the living member of its own team closest to it.
+         * @param enemyTeam Pointer to the enemy team.
+         * @return Done, NullTarget, SelfTarget, TeamEliminated, or the status of a rejected action.
+         * @throws std::bad_alloc If the nearest-fighter index of a team can't grow.
+         */
+        CombatStatus tryAttack(Team *enemyTeam) override {
+            CombatStatus status = checkOpponent(enemyTeam);
+            if (failed(status)) {
+                return status;
+            }
+            replaceDeadLeader();
+            Character *victim = this->targeting.first(*this, enemyTeam);
+            Order::forEach(*this, [&](std::size_t slot) {
+                Character *attacker = this->getFighters()[slot];
+                if (!attacker->isAlive()) {
+                    return true;
+                }
+                if (!victim->isAlive()) {
+                    victim = this->targeting.next(*this, enemyTeam);
+                }
+                status = act(attacker, victim);
+                if (failed(status) || this->stillAlive() == 0 || enemyTeam->stillAlive() == 0) {
+                    return false;
+                }
+                replaceDeadEnemyLeader(enemyTeam);
+                return true;
+            });
+            return failed(status) ? status : CombatStatus::Done;
+        }
+
+        using Team::print;
+
+        /**
+         * @brief Appends the details of the living fighters of the team to a string, in the order they act.
+         * @param out The string appended to, its capacity is reused.
+         */
+        void print(std::string &out) const override {
+            printHeader(out);
+            Order::forEach(*this, [&](std::size_t slot) {
+                this->getFighters()[slot]->print(out);
+                out += '\n';
+                return true;
+            });
+        }
+    };
+
+    // The strategy of Team, which implements it with a cowboy volley: cowboys first, nearest enemy.
+    using NearestTeam = StrategyTeam<NearestTargeting, CowboysFirst>;
+
+}
+
+#endif //COWBOY_VS_NINJA_B_STRATEGYTEAM_HPP
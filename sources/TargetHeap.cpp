@@ -0,0 +1,300 @@
+/**
+ * @file TargetHeap.cpp
+ * @brief Implementation of the TargetHeap class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "TargetHeap.hpp"
+#include <stdexcept>
+#include "Team.hpp"
+
+namespace ariel {
+
+    namespace {
+        const unsigned KIND_SHIFT = 39;
+        const unsigned HIT_POINTS_SHIFT = 40;
+    }
+
+/**
+ * @brief Constructs a heap that watches no team yet.
+ */
+    TargetHeap::TargetHeap() : watched(nullptr) {}
+
+/**
+ * @brief Stops watching the enemy team.
+ */
+    TargetHeap::~TargetHeap() {
+        if (this->watched) {
+            this->watched->removeWatcher(this);
+        }
+    }
+
+/**
+ * @brief Packs the priority of a fighter into a key, smaller keys are attacked first.
+ * @param slot The slot of the fighter, the last tie breaker.
+ * @param hitPoints The hit points of the fighter.
+ * @param kind Cowboys come before ninjas with as many hit points.
+ * @return The key.
+ */
+    std::uint64_t TargetHeap::keyOf(std::size_t slot, int hitPoints, FighterKind kind) {
+        return (static_cast<std::uint64_t>(hitPoints) << HIT_POINTS_SHIFT) |
+               (static_cast<std::uint64_t>(kind == FighterKind::Ninja) << KIND_SHIFT) | slot;
+    }
+
+/**
+ * @brief Unpacks the slot of a key.
+ * @param key The key.
+ * @return The slot of the fighter.
+ */
+    std::size_t TargetHeap::slotOf(std::uint64_t key) {
+        return static_cast<std::size_t>(key & ((std::uint64_t{1} << KIND_SHIFT) - 1));
+    }
+
+/**
+ * @brief Stores a key at an index of the heap and records where its slot is.
+ * @param index The index in the heap.
+ * @param key The key.
+ */
+    void TargetHeap::place(std::size_t index, std::uint64_t key) {
+        this->heap[index] = key;
+        this->position[slotOf(key)] = index;
+    }
+
+/**
+ * @brief Moves the key at an index up until its parent is smaller.
+ * @param index The index in the heap.
+ */
+    void TargetHeap::siftUp(std::size_t index) {
+        std::uint64_t key = this->heap[index];
+        while (index > 0) {
+            std::size_t parent = (index - 1) / 2;
+            if (this->heap[parent] <= key) {
+                break;
+            }
+            place(index, this->heap[parent]);
+            index = parent;
+        }
+        place(index, key);
+    }
+
+/**
+ * @brief Moves the key at an index down until its children are larger.
+ * @param index The index in the heap.
+ */
+    void TargetHeap::siftDown(std::size_t index) {
+        std::uint64_t key = this->heap[index];
+        const std::size_t count = this->heap.size();
+        while (true) {
+            std::size_t child = 2 * index + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && this->heap[child + 1] < this->heap[child]) {
+                child++;
+            }
+            if (key <= this->heap[child]) {
+                break;
+            }
+            place(index, this->heap[child]);
+            index = child;
+        }
+        place(index, key);
+    }
+
+/**
+ * @brief Rebuilds the heap from the living fighters of the watched team in O(n).
+ */
+    void TargetHeap::rebuild() {
+        this->heap.clear();
+        this->position.assign(this->watched ? this->watched->getFighters().size() : 0, npos);
+        if (!this->watched) {
+            return;
+        }
+        const std::vector<Character *> &fighters = this->watched->getFighters();
+        if (fighters.size() > MAX_SLOTS) {
+            throw std::length_error("Error: The roster is too large to be ordered by priority.");
+        }
+        for (std::size_t slot = 0; slot < fighters.size(); slot++) {
+            if (fighters[slot]->isAlive()) {
+                this->position[slot] = this->heap.size();
+                this->heap.push_back(keyOf(slot, fighters[slot]->getHitPoints(), fighters[slot]->getKind()));
+            }
+        }
+        for (std::size_t index = this->heap.size() / 2; index-- > 0;) {
+            siftDown(index);
+        }
+    }
+
+/**
+ * @brief Orders the fighters of an enemy team and keeps the order up to date from then on, until another team
+ * is watched.
+ * @param enemyTeam The team, nullptr to stop watching.
+ * @throws std::length_error If the roster has MAX_SLOTS fighters or more.
+ */
+    void TargetHeap::watch(Team *enemyTeam) {
+        if (this->watched) {
+            this->watched->removeWatcher(this);
+        }
+        this->watched = enemyTeam;
+        if (this->watched) {
+            this->watched->addWatcher(this);
+        }
+        rebuild();
+    }
+
+/**
+ * @brief Getter for the team ordered.
+ * @return The watched team, nullptr if there is none.
+ */
+    Team *TargetHeap::getWatched() const {
+        return this->watched;
+    }
+
+/**
+ * @brief Checks if the watched team has living fighters.
+ * @return True if there is nobody left to attack.
+ */
+    bool TargetHeap::empty() const {
+        return this->heap.empty();
+    }
+
+/**
+ * @brief Getter for the number of living fighters ordered.
+ * @return The size of the heap.
+ */
+    std::size_t TargetHeap::size() const {
+        return this->heap.size();
+    }
+
+/**
+ * @brief The slot of the next target.
+ * @return The slot of the living fighter with the fewest hit points, npos if there is none.
+ */
+    std::size_t TargetHeap::topSlot() const {
+        return this->heap.empty() ? npos : slotOf(this->heap.front());
+    }
+
+/**
+ * @brief The next target.
+ * @return The living fighter with the fewest hit points, cowboys first, nullptr if there is none.
+ */
+    Character *TargetHeap::top() const {
+        return this->heap.empty() ? nullptr : this->watched->getFighters()[slotOf(this->heap.front())];
+    }
+
+/**
+ * @brief Checks if a fighter is in the heap.
+ * @param slot The slot of the fighter.
+ * @return True if the fighter is ordered, i.e. alive.
+ */
+    bool TargetHeap::contains(std::size_t slot) const {
+        return slot < this->position.size() && this->position[slot] != npos;
+    }
+
+/**
+ * @brief Adds a fighter that came back to life or joined the watched team.
+ * @param slot The slot of the fighter.
+ */
+    void TargetHeap::insert(std::size_t slot) {
+        if (slot >= this->position.size()) {
+            this->position.resize(slot + 1, npos);
+        }
+        if (this->position[slot] != npos) {
+            update(slot);
+            return;
+        }
+        const Character *fighter = this->watched->getFighters()[slot];
+        this->heap.push_back(keyOf(slot, fighter->getHitPoints(), fighter->getKind()));
+        siftUp(this->heap.size() - 1);
+    }
+
+/**
+ * @brief Moves a fighter to its place after its hit points changed, up when it was hit, down when it was healed.
+ * @param slot The slot of a fighter in the heap.
+ */
+    void TargetHeap::update(std::size_t slot) {
+        if (!contains(slot)) {
+            return;
+        }
+        std::size_t index = this->position[slot];
+        const Character *fighter = this->watched->getFighters()[slot];
+        std::uint64_t key = keyOf(slot, fighter->getHitPoints(), fighter->getKind());
+        std::uint64_t previous = this->heap[index];
+        this->heap[index] = key;
+        if (key < previous) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+/**
+ * @brief Takes a fighter that died out of the heap.
+ * @param slot The slot of the fighter, nothing happens if it is not in the heap.
+ */
+    void TargetHeap::remove(std::size_t slot) {
+        if (!contains(slot)) {
+            return;
+        }
+        std::size_t index = this->position[slot];
+        this->position[slot] = npos;
+        std::uint64_t last = this->heap.back();
+        this->heap.pop_back();
+        if (index == this->heap.size()) {
+            return;
+        }
+        std::uint64_t removed = this->heap[index];
+        this->heap[index] = last;
+        if (last < removed) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+/**
+ * @brief Moves don't change the priority of a fighter.
+ */
+    void TargetHeap::fighterMoved(std::size_t /*slot*/, const Point & /*from*/, const Point & /*to*/) {}
+
+/**
+ * @brief Removes a fighter of the watched team that died.
+ * @param slot The slot of the fighter.
+ */
+    void TargetHeap::fighterDied(std::size_t slot) {
+        remove(slot);
+    }
+
+/**
+ * @brief Inserts a fighter of the watched team that came back to life or joined it.
+ * @param slot The slot of the fighter.
+ */
+    void TargetHeap::fighterRevived(std::size_t slot) {
+        insert(slot);
+    }
+
+/**
+ * @brief Moves a fighter of the watched team that was hit (decrease-key) or healed.
+ * @param slot The slot of the fighter.
+ */
+    void TargetHeap::fighterHit(std::size_t slot, int /*hitPoints*/) {
+        update(slot);
+    }
+
+/**
+ * @brief Rebuilds the heap after the whole watched team was restored from a snapshot.
+ */
+    void TargetHeap::fightersRestored() {
+        rebuild();
+    }
+
+/**
+ * @brief Forgets the watched team, which is being destroyed.
+ */
+    void TargetHeap::fightersReleased() {
+        this->watched = nullptr;
+        rebuild();
+    }
+
+}
@@ -0,0 +1,98 @@
+/**
+ * @file TargetHeap.hpp
+ * @brief Indexable min-heap of the living fighters of an enemy team in target priority order: fewest hit points
+ * first, cowboys before ninjas, then roster order.
+ * The heap watches the enemy team, so it lives across turns: a hit moves the fighter up the heap (decrease-key),
+ * a death removes it and a revival puts it back, each in O(log n), and the next target is read in O(1).
+ * Every entry packs its whole sort key into one integer, so the heap compares without touching the fighters.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_TARGETHEAP_HPP
+#define COWBOY_VS_NINJA_B_TARGETHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Character.hpp"
+
+namespace ariel {
+
+    class Team;
+
+    class TargetHeap : public FighterObserver {
+    private:
+        Team *watched;
+        // Packed keys: hit points, then 0 for a cowboy or 1 for a ninja, then the slot
+        std::vector<std::uint64_t> heap;
+        // Index of every slot in the heap, npos for the dead
+        std::vector<std::size_t> position;
+
+        static std::uint64_t keyOf(std::size_t slot, int hitPoints, FighterKind kind);
+
+        static std::size_t slotOf(std::uint64_t key);
+
+        void place(std::size_t index, std::uint64_t key);
+
+        void siftUp(std::size_t index);
+
+        void siftDown(std::size_t index);
+
+        void rebuild();
+
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+        // The slots of a roster must fit below the hit points and the kind in a key.
+        static constexpr std::size_t MAX_SLOTS = std::size_t{1} << 39U;
+
+        TargetHeap();
+
+        ~TargetHeap() override;
+
+        void watch(Team *enemyTeam);
+
+        Team *getWatched() const;
+
+        bool empty() const;
+
+        std::size_t size() const;
+
+        std::size_t topSlot() const;
+
+        Character *top() const;
+
+        bool contains(std::size_t slot) const;
+
+        void insert(std::size_t slot);
+
+        void update(std::size_t slot);
+
+        void remove(std::size_t slot);
+
+        void fighterMoved(std::size_t slot, const Point &from, const Point &to) override;
+
+        void fighterDied(std::size_t slot) override;
+
+        void fighterRevived(std::size_t slot) override;
+
+        void fighterHit(std::size_t slot, int hitPoints) override;
+
+        void fightersRestored() override;
+
+        void fightersReleased() override;
+
+        // Make tidy make me write this
+        TargetHeap(const TargetHeap &) = delete;
+
+        TargetHeap &operator=(const TargetHeap &) = delete;
+
+        TargetHeap(TargetHeap &&) = delete;
+
+        TargetHeap &operator=(TargetHeap &&) = delete;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_TARGETHEAP_HPP
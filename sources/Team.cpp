@@ -2,6 +2,7 @@
  * @file Team.cpp
  * @brief Represents a group of fighters, consisting of ninjas and cowboys.
  * This class is a group of up to ten fighters, where a fighter can be a ninja or a warrior.
+ * Large-roster teams lift the limit by passing their own capacity to the constructor.
  * Each group is assigned a leader who is one of the fighters. When a group is created, it gets a leader pointer.
  * @note The order in attack,print , compering is first cowboys then ninja.
  * @author Tomer Gozlan
@@ -9,28 +10,114 @@
  */
 
 #include "Team.hpp"
+#include <charconv>
 
 namespace ariel {
 
+    namespace {
+        /**
+         * @brief Reports a rejected team action as the exception the throwing API has always used.
+         * @param status The outcome of the action.
+         */
+        void throwIfFailed(CombatStatus status) {
+            switch (status) {
+                case CombatStatus::NullTarget:
+                    throw std::invalid_argument("Error: Invalid pointer to enemy team.");
+                case CombatStatus::SelfTarget:
+                    throw std::runtime_error("Error: Team must attack the enemy team not herself.");
+                case CombatStatus::TeamEliminated:
+                    throw std::runtime_error("Error: One of the teams was completely eliminated.");
+                default:
+                    if (failed(status)) {
+                        throw std::runtime_error("Error: A fighter of the team could not act.");
+                    }
+            }
+        }
+    }
+
+/**
+ * @brief Constructs a team of up to ten fighters with the specified leader.
+ * @param leader Pointer to the leader of the team.
+ * @throws std::invalid_argument If the leader pointer is invalid.
+ * @throws std::runtimer_error If the leader is already member in other team.
+ */
+    Team::Team(Character *leader) : Team(leader, MAX_FIGHTERS) {}
+
 /**
- * @brief Constructs a team with the specified leader.
+ * @brief Constructs a team with the specified leader and roster size limit.
  * @param leader Pointer to the leader of the team.
- * @throws std::invalid_argument If the leader pointer is invalid or the team already has ten fighters.
+ * @param capacity The maximal number of fighters, leader included. Team::UNLIMITED for a large-roster team.
+ * @throws std::invalid_argument If the leader pointer is invalid or the capacity has no room for the leader.
  * @throws std::runtimer_error If the leader is already member in other team.
  */
-    Team::Team(Character *leader) : leader(leader) {
+    Team::Team(Character *leader, std::size_t capacity) : leader(leader), capacity(capacity),
+                                                          liveIndexBuilt(false), aliveCount(0),
+                                                          liveSlotsCompacted(true), liveSlotsStale(false),
+                                                          vectorizedSearch(false), packedBuilt(false),
+                                                          recorder(nullptr), replaySide(0) {
         if (!leader) {
             throw std::invalid_argument("Error: Invalid pointer to team leader.");
         }
         if (leader->isTeamMember()) {
             throw std::runtime_error("Error: The leader is already in team.");
         }
-        if (this->fighters.size() >= 10) {
-            throw std::invalid_argument("Error: The team cannot have more than ten fighters.");
+        if (capacity == 0) {
+            throw std::invalid_argument("Error: The team must have room for its leader.");
         }
-        fighters.push_back(leader);
         this->leader = leader;
-        this->leader->setTeamMember(true);
+        enlist(leader);
+    }
+
+/**
+ * @brief Appends a fighter to the roster and starts observing it.
+ * @param fighter The new member of the team.
+ */
+    void Team::enlist(Character *fighter) {
+        fighter->setObserver(this, this->fighters.size());
+        this->fighters.push_back(fighter);
+        fighter->setTeamMember(true);
+        if (fighter->isAlive()) {
+            this->aliveCount++;
+            if (!this->liveSlotsStale) {
+                this->liveSlots.push_back(this->fighters.size() - 1);
+            }
+            if (this->liveIndexBuilt) {
+                Point location = fighter->getLocation();
+                this->liveIndex.insert(this->fighters.size() - 1, location.getX(), location.getY());
+            }
+            for (FighterObserver *watcher: this->watchers) {
+                watcher->fighterRevived(this->fighters.size() - 1);
+            }
+        }
+        if (this->packedBuilt) {
+            Point location = fighter->getLocation();
+            this->packedX.push_back(location.getX());
+            this->packedY.push_back(location.getY());
+            this->packedAlive.push_back(fighter->isAlive() ? 1 : 0);
+        }
+        enlisted(fighter);
+    }
+
+/**
+ * @brief Brings the derived state of the team (alive count, live slots, nearest-search indexes) back in step with
+ * fighters whose state was overwritten by a BattleSnapshot without notifying the team.
+ * The indexes are rebuilt on their next use, as after construction.
+ * @param restoredLeader The leader of the team at the time of the snapshot.
+ */
+    void Team::stateRestored(Character *restoredLeader) {
+        this->leader = restoredLeader;
+        this->aliveCount = 0;
+        for (const Character *fighter: this->fighters) {
+            if (fighter->isAlive()) {
+                this->aliveCount++;
+            }
+        }
+        this->liveSlotsStale = true;
+        this->liveIndexBuilt = false;
+        this->packedBuilt = false;
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fightersRestored();
+        }
     }
 
 /**
@@ -49,11 +136,44 @@ namespace ariel {
         return fighters;
     }
 
+/**
+ * @brief Get the slots of the living fighters, in roster order.
+ * The list is maintained from the death and revival notifications of the fighters: deaths are dropped with a
+ * single compaction pass the next time the list is read, a revival rebuilds it.
+ * @return A reference to the slots of the living fighters in getFighters().
+ */
+    const std::vector<std::size_t> &Team::getLiveSlots() const {
+        if (this->liveSlotsStale) {
+            this->liveSlots.clear();
+            for (std::size_t slot = 0; slot < this->fighters.size(); slot++) {
+                if (this->fighters[slot]->isAlive()) {
+                    this->liveSlots.push_back(slot);
+                }
+            }
+            this->liveSlotsStale = false;
+            this->liveSlotsCompacted = true;
+        } else if (!this->liveSlotsCompacted) {
+            auto dead = std::remove_if(this->liveSlots.begin(), this->liveSlots.end(),
+                                       [this](std::size_t slot) { return !this->fighters[slot]->isAlive(); });
+            this->liveSlots.erase(dead, this->liveSlots.end());
+            this->liveSlotsCompacted = true;
+        }
+        return this->liveSlots;
+    }
+
+/**
+ * @brief Get the maximal number of fighters in the team.
+ * @return The capacity the team was constructed with.
+ */
+    std::size_t Team::getCapacity() const {
+        return this->capacity;
+    }
+
 /**
  * @brief Adds a fighter to the team.
  * @param fighter Pointer to the fighter to be added.
- * @throws std::invalid_argument If the fighter pointer is invalid or the team already has ten fighters.
- * @throws std:runtime_error If the character is already in some team and if there are more then 10 fighters in team.
+ * @throws std::invalid_argument If the fighter pointer is invalid.
+ * @throws std:runtime_error If the character is already in some team or the team is full.
  */
     void Team::add(Character *fighter) {
         if (!fighter) {
@@ -62,11 +182,10 @@ namespace ariel {
         if (fighter->isTeamMember()) {
             throw std::runtime_error("Error: The character is already in some team.");
         }
-        if (this->fighters.size() >= 10) {
-            throw std::runtime_error("Error: The team cannot have more than ten fighters.");
+        if (this->fighters.size() >= this->capacity) {
+            throw std::runtime_error("Error: The team cannot have more fighters than its capacity.");
         }
-        this->fighters.push_back(fighter);
-        fighter->setTeamMember(true);
+        enlist(fighter);
     }
 
 /**
@@ -77,13 +196,13 @@ namespace ariel {
     Character *
     Team::findClosestCharacter(const ariel::Point &location, const std::vector<Character *> &fighters) const {
         Character *closestCharacter = nullptr;
-        double closestDistance = std::numeric_limits<double>::max();
+        double closestSquared = std::numeric_limits<double>::max();
         for (Character *character: fighters) {
             if (character->isAlive()) {
-                double distance = location.distance(character->getLocation());
-                if (distance < closestDistance) {
+                double squared = location.distanceSquared(character->getLocation());
+                if (squared < closestSquared) {
                     closestCharacter = character;
-                    closestDistance = distance;
+                    closestSquared = squared;
                 }
             }
         }
@@ -91,131 +210,478 @@ namespace ariel {
     }
 
 /**
- * @brief Attacks the enemy team and handles various scenarios, including leader replacement and victim selection.
+ * @brief Finds the living member of the team closest to a location.
+ * Gives the same answer as findClosestCharacter(location, getFighters()), including the choice of the first
+ * checked fighter among equidistant ones. Large teams answer from a spatial index of their living fighters,
+ * or with the vectorized kernel over packed copies of their coordinates if they opted into it. Both are kept up
+ * to date through the fighter notifications.
+ * @param location The location used to calculate the distances.
+ * @return The closest living fighter, nullptr if the whole team is dead.
+ */
+    Character *Team::closestAlive(const Point &location) const {
+        if (this->fighters.size() < INDEX_THRESHOLD) {
+            return findClosestCharacter(location, this->fighters);
+        }
+        if (this->vectorizedSearch) {
+            if (!this->packedBuilt) {
+                this->packedX.clear();
+                this->packedY.clear();
+                this->packedAlive.clear();
+                for (const Character *fighter: this->fighters) {
+                    Point position = fighter->getLocation();
+                    this->packedX.push_back(position.getX());
+                    this->packedY.push_back(position.getY());
+                    this->packedAlive.push_back(fighter->isAlive() ? 1 : 0);
+                }
+                this->packedBuilt = true;
+            }
+            std::size_t slot = NearestKernel::nearest(this->packedX.data(), this->packedY.data(),
+                                                      this->packedAlive.data(), this->fighters.size(),
+                                                      location.getX(), location.getY());
+            return slot == NearestKernel::npos ? nullptr : this->fighters[slot];
+        }
+        if (!this->liveIndexBuilt) {
+            std::vector<SpatialGrid::Entry> entries;
+            for (std::size_t slot = 0; slot < this->fighters.size(); slot++) {
+                if (this->fighters[slot]->isAlive()) {
+                    Point position = this->fighters[slot]->getLocation();
+                    entries.push_back(SpatialGrid::Entry{slot, position.getX(), position.getY()});
+                }
+            }
+            this->liveIndex.build(entries);
+            this->liveIndexBuilt = true;
+        }
+        std::size_t slot = this->liveIndex.nearest(location.getX(), location.getY());
+        return slot == SpatialGrid::npos ? nullptr : this->fighters[slot];
+    }
+
+/**
+ * @brief Chooses how a large team searches for its closest living fighter.
+ * Both searches give the same answers. The spatial index is best when the same location is queried while
+ * fighters die around it; the vectorized scan has no upkeep beyond copying coordinates when fighters move.
+ * @param enabled True for the vectorized scan, false for the spatial index.
+ */
+    void Team::useVectorizedSearch(bool enabled) {
+        this->vectorizedSearch = enabled;
+        this->packedBuilt = false;
+        this->liveIndexBuilt = false;
+        this->liveIndex.clear();
+    }
+
+/**
+ * @brief Checks which search a large team uses for its closest living fighter.
+ * @return True if it uses the vectorized scan.
+ */
+    bool Team::usesVectorizedSearch() const {
+        return this->vectorizedSearch;
+    }
+
+/**
+ * @brief Starts or stops recording the events of the team: the actions of its fighters, their deaths and the
+ * changes of its leader. Attach the recorder to both teams of a battle to record all of it.
+ * @param newRecorder The recorder, nullptr to stop recording.
+ * @param side The value of the team field of the records of this team.
+ */
+    void Team::recordTo(ReplayRecorder *newRecorder, std::uint8_t side) {
+        this->recorder = newRecorder;
+        this->replaySide = side;
+    }
+
+/**
+ * @brief Records a shot or a slash that is about to hit, before its damage is dealt, so that the death it may
+ * cause is recorded after it. Nothing is recorded if the team is not recording.
+ * @param event Shoot or Slash.
+ * @param attacker The fighter of this team.
+ * @param victim The enemy it hits.
+ * @param damage The damage it deals.
+ */
+    void Team::recordAttack(ReplayEvent event, const Character *attacker, const Character *victim, int damage) const {
+        if (this->recorder) {
+            int left = std::max(0, victim->getHitPoints() - damage);
+            this->recorder->record(event, this->replaySide, attacker->getObserverSlot(), victim->getObserverSlot(),
+                                   damage, left);
+        }
+    }
+
+/**
+ * @brief Records a move or a reload that took place, with the location of the fighter after it.
+ * Nothing is recorded if the team is not recording.
+ * @param event Move or Reload.
+ * @param actor The fighter of this team.
+ * @param target The enemy moved towards, nullptr if there is none.
+ */
+    void Team::recordAction(ReplayEvent event, const Character *actor, const Character *target) const {
+        if (this->recorder) {
+            Point location = actor->getLocation();
+            this->recorder->record(event, this->replaySide, actor->getObserverSlot(),
+                                   target ? target->getObserverSlot() : ReplayRecord::NONE, location.getX(),
+                                   location.getY());
+        }
+    }
+
+/**
+ * @brief Keeps the spatial index, the packed coordinates and the watchers in step with a fighter that changed its
+ * location.
+ * @param slot The slot of the fighter in the roster.
+ * @param from The previous location.
+ * @param to The new location.
+ */
+    void Team::fighterMoved(std::size_t slot, const Point &from, const Point &to) {
+        if (this->liveIndexBuilt && this->fighters[slot]->isAlive()) {
+            this->liveIndex.move(slot, from.getX(), from.getY(), to.getX(), to.getY());
+        }
+        if (this->packedBuilt) {
+            this->packedX[slot] = to.getX();
+            this->packedY[slot] = to.getY();
+        }
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fighterMoved(slot, from, to);
+        }
+    }
+
+/**
+ * @brief Drops a fighter that just died from the alive count, the live slots and the nearest searches.
+ * @param slot The slot of the fighter in the roster.
+ */
+    void Team::fighterDied(std::size_t slot) {
+        this->aliveCount--;
+        this->liveSlotsCompacted = false;
+        if (this->liveIndexBuilt) {
+            Point location = this->fighters[slot]->getLocation();
+            this->liveIndex.erase(slot, location.getX(), location.getY());
+        }
+        if (this->packedBuilt) {
+            this->packedAlive[slot] = 0;
+        }
+        if (this->recorder) {
+            Point location = this->fighters[slot]->getLocation();
+            this->recorder->record(ReplayEvent::Death, this->replaySide, slot, ReplayRecord::NONE, location.getX(),
+                                   location.getY());
+        }
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fighterDied(slot);
+        }
+    }
+
+/**
+ * @brief Puts a fighter brought back to life back into the alive count, the live slots and the nearest searches.
+ * @param slot The slot of the fighter in the roster.
+ */
+    void Team::fighterRevived(std::size_t slot) {
+        this->aliveCount++;
+        this->liveSlotsStale = true;
+        if (this->liveIndexBuilt) {
+            Point location = this->fighters[slot]->getLocation();
+            this->liveIndex.insert(slot, location.getX(), location.getY());
+        }
+        if (this->packedBuilt) {
+            this->packedAlive[slot] = 1;
+        }
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fighterRevived(slot);
+        }
+    }
+
+/**
+ * @brief Passes a change of hit points that neither killed nor revived a fighter on to the watchers of the team.
+ * @param slot The slot of the fighter in the roster.
+ * @param hitPoints The hit points of the fighter now.
+ */
+    void Team::fighterHit(std::size_t slot, int hitPoints) {
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fighterHit(slot, hitPoints);
+        }
+    }
+
+/**
+ * @brief Starts passing the moves, deaths, revivals and hits of the fighters of the team on to another observer,
+ * e.g. the target order an enemy keeps of the team. A fighter joining the team alive is reported as a revival.
+ * The watcher is told when the team is destroyed and must be removed before it is destroyed itself.
+ * @param watcher The observer, told about every slot of the roster.
+ */
+    void Team::addWatcher(FighterObserver *watcher) {
+        this->watchers.push_back(watcher);
+    }
+
+/**
+ * @brief Stops passing the changes of the fighters of the team on to an observer.
+ * @param watcher An observer added with addWatcher, nothing happens if it was not.
+ */
+    void Team::removeWatcher(FighterObserver *watcher) {
+        this->watchers.erase(std::remove(this->watchers.begin(), this->watchers.end(), watcher),
+                             this->watchers.end());
+    }
+
+/**
+ * @brief Checks that a team can attack another one.
  * @param enemyTeam Pointer to the enemy team.
- * @throws std::invalid_argument If the enemyTeam pointer is invalid.
- * @throw std::invalid_argument If the ninja type dont fit to the three type: Young,Trained,Old Ninja.
+ * @return Done, or why the attack is rejected: NullTarget, SelfTarget or TeamEliminated.
  */
-    void Team::attack(ariel::Team *enemyTeam) {
+    CombatStatus Team::checkOpponent(const ariel::Team *enemyTeam) const noexcept {
         if (!enemyTeam) {
-            throw std::invalid_argument("Error: Invalid pointer to enemy team.");
+            return CombatStatus::NullTarget;
         }
         if (this == enemyTeam) {
-            throw std::runtime_error("Error: Team must attack the enemy team not herself.");
+            return CombatStatus::SelfTarget;
         }
         if (this->stillAlive() == 0 || enemyTeam->stillAlive() == 0) {
-            throw std::runtime_error("Error: One of the teams was completely eliminated.");
+            return CombatStatus::TeamEliminated;
         }
-        if (!(this->leader->isAlive())) {
-            Point leaderLocation = this->leader->getLocation();
-            Character *newLeader = findClosestCharacter(leaderLocation, this->getFighters());
-            this->leader = newLeader;
+        return CombatStatus::Done;
+    }
+
+/**
+ * @brief Fires one volley: every living cowboy of the team, in roster order, shoots the enemy closest to the leader
+ * or reloads an empty gun.
+ * @param enemyTeam Pointer to the enemy team.
+ * @return The victim the volley ended on (wounded but alive), nullptr if the enemy team was eliminated.
+ * @throws std::invalid_argument If the enemyTeam pointer is invalid.
+ * @throws std::runtime_error If the team attacks itself or one of the teams was completely eliminated.
+ */
+    Character *Team::volley(ariel::Team *enemyTeam) {
+        Character *victim = nullptr;
+        throwIfFailed(tryVolley(enemyTeam, victim));
+        return victim;
+    }
+
+/**
+ * @brief Fires one volley, reporting a rejection as a status instead of throwing.
+ * The shots are resolved exactly as one shoot() per cowboy would resolve them, but without the checks of shoot():
+ * the damage is summed per victim and dealt in a single hit once it is lethal, and only then is the next victim
+ * chosen. A dead enemy leader is replaced after the action it died in, like in attack().
+ * @param enemyTeam Pointer to the enemy team.
+ * @param victim Set to the victim the volley ended on, nullptr if the enemy team was eliminated.
+ * @return Done, or why the volley was rejected: NullTarget, SelfTarget or TeamEliminated.
+ * @throws std::bad_alloc If the nearest-fighter index of a team can't grow, the only exception it lets through.
+ */
+    CombatStatus Team::tryVolley(ariel::Team *enemyTeam, Character *&victim) {
+        victim = nullptr;
+        CombatStatus status = checkOpponent(enemyTeam);
+        if (failed(status)) {
+            return status;
         }
-        Character *victim = findClosestCharacter(this->leader->getLocation(), enemyTeam->getFighters());
+        replaceDeadLeader();
+        victim = enemyTeam->closestAlive(this->leader->getLocation());
+        // Damage already done to the victim by this volley but not dealt yet
+        int pendingDamage = 0;
 
-        for (Character *attacker: fighters) {
-            if (!victim->isAlive()) {
-                victim = findClosestCharacter(leader->getLocation(), enemyTeam->getFighters());
-            }
-            if (attacker->isAlive() && victim->isAlive()) {
-                if (Cowboy *cowboy = dynamic_cast<Cowboy *>(attacker)) {
-                    if (cowboy->hasboolets()) {
-                        cowboy->shoot(victim);
-                    } else {
-                        cowboy->reload();
+        for (std::size_t slot: getLiveSlots()) {
+            Character *attacker = fighters[slot];
+            if (attacker->isAlive() && attacker->getKind() == FighterKind::Cowboy) {
+                auto *cowboy = static_cast<Cowboy *>(attacker);
+                if (cowboy->hasboolets()) {
+                    cowboy->setBullets(cowboy->getBullets() - 1);
+                    if (this->recorder) {
+                        int left = std::max(0, victim->getHitPoints() - pendingDamage - Cowboy::SHOT_DAMAGE);
+                        this->recorder->record(ReplayEvent::Shoot, this->replaySide, slot,
+                                               victim->getObserverSlot(), Cowboy::SHOT_DAMAGE, left);
+                    }
+                    pendingDamage += Cowboy::SHOT_DAMAGE;
+                    if (pendingDamage >= victim->getHitPoints()) {
+                        victim->tryHit(pendingDamage);
+                        pendingDamage = 0;
+                        if (enemyTeam->stillAlive() == 0) {
+                            victim = nullptr;
+                            return CombatStatus::Done;
+                        }
+                        victim = enemyTeam->closestAlive(this->leader->getLocation());
                     }
+                } else {
+                    cowboy->tryReload();
+                    recordAction(ReplayEvent::Reload, cowboy, nullptr);
                 }
             }
-            if (this->stillAlive() == 0 || enemyTeam->stillAlive() == 0) {
-                return;
-            }
+            replaceDeadEnemyLeader(enemyTeam);
+        }
+        if (pendingDamage > 0) {
+            victim->tryHit(pendingDamage);
+        }
+        return CombatStatus::Done;
+    }
 
-            if (!enemyTeam->leader->isAlive()) {
-                Point enemyLeaderLocation = enemyTeam->leader->getLocation();
-                Character *enemyNewLeader;
-                enemyNewLeader = findClosestCharacter(enemyLeaderLocation, enemyTeam->getFighters());
-                enemyTeam->leader = enemyNewLeader;
-            }
+/**
+ * @brief Attacks the enemy team and handles various scenarios, including leader replacement and victim selection.
+ * A thin wrapper reporting the failures of tryAttack() as exceptions.
+ * @param enemyTeam Pointer to the enemy team.
+ * @throws std::invalid_argument If the enemyTeam pointer is invalid.
+ * @throws std::runtime_error If the team attacks itself, one of the teams was completely eliminated or a fighter
+ * could not act.
+ */
+    void Team::attack(ariel::Team *enemyTeam) {
+        throwIfFailed(tryAttack(enemyTeam));
+    }
+
+/**
+ * @brief Attacks the enemy team, reporting a rejection as a status instead of throwing: the cowboys act first with
+ * a volley, then the ninjas attack the victim it ended on.
+ * @param enemyTeam Pointer to the enemy team.
+ * @return Done, or why the attack was rejected: NullTarget, SelfTarget or TeamEliminated.
+ * @throws std::bad_alloc If the nearest-fighter index of a team can't grow, the only exception it lets through.
+ */
+    CombatStatus Team::tryAttack(ariel::Team *enemyTeam) {
+        Character *victim = nullptr;
+        CombatStatus status = tryVolley(enemyTeam, victim);
+        if (failed(status) || !victim) {
+            return status;
         }
-        for (Character *attacker: fighters) {
+        for (std::size_t slot: getLiveSlots()) {
+            Character *attacker = fighters[slot];
             if (!victim->isAlive()) {
-                victim = findClosestCharacter(leader->getLocation(), enemyTeam->getFighters());
-            }
-            if (attacker->isAlive() && victim->isAlive()) {
-                if (Ninja *ninja = dynamic_cast<Ninja *>(attacker)) {
-                    double distance = ninja->getLocation().distance(victim->getLocation());
-                    if (distance < 1) {
-                        ninja->slash(victim);
-                    } else {
-                        ninja->move(victim);
-                    }
+                victim = enemyTeam->closestAlive(leader->getLocation());
+            }
+            if (attacker->isAlive() && victim->isAlive() && attacker->getKind() == FighterKind::Ninja) {
+                status = act(attacker, victim);
+                if (failed(status)) {
+                    return status;
                 }
             }
             if (this->stillAlive() == 0 || enemyTeam->stillAlive() == 0) {
-                return;
+                return CombatStatus::Done;
             }
-            if (!enemyTeam->leader->isAlive()) {
-                Point enemyLeaderLocation = enemyTeam->leader->getLocation();
-                Character *enemyNewLeader;
-                enemyNewLeader = findClosestCharacter(enemyLeaderLocation, enemyTeam->getFighters());
-                enemyTeam->leader = enemyNewLeader;
+            replaceDeadEnemyLeader(enemyTeam);
+        }
+        return CombatStatus::Done;
+    }
+
+/**
+ * @brief Appoints the living fighter closest to the dead leader of the team as its new leader.
+ * Nothing changes while the leader is alive.
+ */
+    void Team::replaceDeadLeader() {
+        if (!this->leader->isAlive()) {
+            Point leaderLocation = this->leader->getLocation();
+            setLeader(closestAlive(leaderLocation));
+        }
+    }
+
+/**
+ * @brief Appoints the living enemy closest to the dead leader of the enemy team as its new leader.
+ * Nothing changes while the leader is alive.
+ * @param enemyTeam The team whose leader may have just been killed.
+ */
+    void Team::replaceDeadEnemyLeader(Team *enemyTeam) {
+        if (!enemyTeam->leader->isAlive()) {
+            Point enemyLeaderLocation = enemyTeam->leader->getLocation();
+            enemyTeam->setLeader(enemyTeam->closestAlive(enemyLeaderLocation));
+        }
+    }
+
+/**
+ * @brief The action of a single fighter against its victim: a cowboy shoots it, or reloads when out of bullets,
+ * a ninja slashes it when within reach, or moves towards it otherwise.
+ * @param attacker The living fighter of this team acting.
+ * @param victim The living enemy it attacks.
+ * @return The status of the action.
+ */
+    CombatStatus Team::act(Character *attacker, Character *victim) {
+        if (attacker->getKind() == FighterKind::Cowboy) {
+            auto *cowboy = static_cast<Cowboy *>(attacker);
+            if (!cowboy->hasboolets()) {
+                CombatStatus status = cowboy->tryReload();
+                recordAction(ReplayEvent::Reload, cowboy, nullptr);
+                return status;
             }
+            recordAttack(ReplayEvent::Shoot, cowboy, victim, Cowboy::SHOT_DAMAGE);
+            return cowboy->tryShoot(victim);
+        }
+        auto *ninja = static_cast<Ninja *>(attacker);
+        if (ninja->getLocation().withinRadius(victim->getLocation(), Ninja::SLASH_RANGE)) {
+            recordAttack(ReplayEvent::Slash, ninja, victim, Ninja::SLASH_DAMAGE);
+            return ninja->trySlash(victim);
         }
+        CombatStatus status = ninja->tryMove(victim);
+        recordAction(ReplayEvent::Move, ninja, victim);
+        return status;
     }
 
 
 /**
 * @brief Checks the number of alive members in the team.
+* The count is kept up to date by the death and revival notifications of the fighters, so this is O(1).
 * @return The number of members in the team that are still alive.
 */
     int Team::stillAlive() const {
-        int counter = 0;
-        for (Character *fighter: this->fighters) {
-            if (fighter->isAlive()) {
-                counter++;
-            }
-        }
-        return counter;
+        return static_cast<int>(this->aliveCount);
     }
 
     void Team::setLeader(ariel::Character *newLeader) {
+        if (this->recorder && newLeader && newLeader != this->leader) {
+            Point location = newLeader->getLocation();
+            this->recorder->record(ReplayEvent::LeaderChange, this->replaySide, newLeader->getObserverSlot(),
+                                   this->leader->getObserverSlot(), location.getX(), location.getY());
+        }
         this->leader=newLeader;
     }
 /**
-* @brief Prints the details of all the fighters in the team.
+* @brief Prints the details of all the fighters in the team to standard output.
 * Prints the details, such as the name, hit points, and location, of all the fighters in the team.
 */
     void Team::print()  {
-        std::cout << "---------------------" << std::endl;
-        std::cout << "Team " << this->leader->getName() << std::endl;
-        std::cout << "---------------------" << std::endl;
-        std::cout << "Team Status: " << (stillAlive() ? "Alive" : "Defeated") << std::endl;
-        std::cout << "Number of Team members: " << (stillAlive() ? std::to_string(stillAlive()) : "0") << std::endl;
-        std::cout << "Team Members:" << std::endl;
-
-        for (Character *member: this->fighters) {
-            if (member->isAlive()) {
-                if (Cowboy *cowboy = dynamic_cast<Cowboy *>(member)) {
-                    std::cout << cowboy->print() << std::endl;
-                }
+        print(std::cout);
+    }
+
+/**
+* @brief Prints the details of all the fighters in the team to a stream with a single write and a single flush.
+* The text is formatted into a buffer kept by the team, so printing every round allocates nothing once the buffer
+* has grown to the size of the team.
+* @param out The stream printed to.
+*/
+    void Team::print(std::ostream &out) {
+        this->printBuffer.clear();
+        print(this->printBuffer);
+        out.write(this->printBuffer.data(), static_cast<std::streamsize>(this->printBuffer.size()));
+        out.flush();
+    }
+
+/**
+* @brief Appends the details of all the fighters in the team to a string, first the cowboys then the ninjas.
+* @param out The string appended to, its capacity is reused.
+*/
+    void Team::print(std::string &out) const {
+        printHeader(out);
+        for (std::size_t slot: getLiveSlots()) {
+            if (this->fighters[slot]->getKind() == FighterKind::Cowboy) {
+                this->fighters[slot]->print(out);
+                out += '\n';
             }
         }
-        for (Character *member: this->fighters) {
-            if (member->isAlive()) {
-                if (Ninja *ninja = dynamic_cast<Ninja *>(member)) {
-                    std::cout << ninja->print() << std::endl;
-                }
+        for (std::size_t slot: getLiveSlots()) {
+            if (this->fighters[slot]->getKind() == FighterKind::Ninja) {
+                this->fighters[slot]->print(out);
+                out += '\n';
             }
         }
     }
 
+/**
+* @brief Appends the lines printed before the fighters: the leader, the status and the number of members.
+* @param out The string appended to.
+*/
+    void Team::printHeader(std::string &out) const {
+        char digits[std::numeric_limits<int>::digits10 + 2];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), stillAlive());
+        out += "---------------------\nTeam ";
+        out += this->leader->getName();
+        out += "\n---------------------\nTeam Status: ";
+        out += stillAlive() ? "Alive" : "Defeated";
+        out += "\nNumber of Team members: ";
+        out.append(digits, result.ptr);
+        out += "\nTeam Members:\n";
+    }
+
 /**
 * @brief Destructor for the Team class.
-* Frees the memory allocated to all the members (fighters) of the team.
+* Frees the memory allocated to all the members (fighters) of the team, fighters living in a FighterArena
+* are left to their arena. The watchers of the team are told first.
 */
     Team::~Team() {
+        for (FighterObserver *watcher: this->watchers) {
+            watcher->fightersReleased();
+        }
         for (Character *fighter: fighters) {
-            delete fighter;
+            if (!fighter->isArenaOwned()) {
+                delete fighter;
+            }
         }
     }
 }
@@ -15,37 +15,143 @@
 #include "TrainedNinja.hpp"
 #include "YoungNinja.hpp"
 #include "Cowboy.hpp"
+#include "SpatialGrid.hpp"
+#include "NearestKernel.hpp"
+#include "ReplayRecorder.hpp"
 #include <vector>
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+#include <string>
 
 namespace ariel {
 
-    class Team {
+    class Team : public FighterObserver {
     private:
         Character *leader;
         std::vector<Character *> fighters;
+        std::size_t capacity;
+        // Index of the living fighters, built on the first nearest-fighter query of a large team.
+        mutable SpatialGrid liveIndex;
+        mutable bool liveIndexBuilt;
+        std::size_t aliveCount;
+        // Slots of the living fighters in roster order, compacted lazily after deaths.
+        mutable std::vector<std::size_t> liveSlots;
+        mutable bool liveSlotsCompacted;
+        mutable bool liveSlotsStale;
+        // Packed coordinates and liveness of the roster for the vectorized nearest search, built on first use.
+        bool vectorizedSearch;
+        mutable std::vector<double> packedX;
+        mutable std::vector<double> packedY;
+        mutable std::vector<int> packedAlive;
+        mutable bool packedBuilt;
+        // Where the events of the team are recorded, nullptr when they are not.
+        ReplayRecorder *recorder;
+        std::uint8_t replaySide;
+        // Reused by print(std::ostream &), so printing every round allocates nothing once it has grown.
+        std::string printBuffer;
+        // Told about the moves, deaths, revivals and hits of the fighters, e.g. the target heaps enemies keep of them.
+        std::vector<FighterObserver *> watchers;
+
+        void enlist(Character *fighter);
+
+        void stateRestored(Character *restoredLeader);
+
+        friend class BattleSnapshot;
+
+        friend class FreeForAll;
+
+    protected:
+        CombatStatus checkOpponent(const Team *enemyTeam) const noexcept;
+
+        void replaceDeadLeader();
+
+        static void replaceDeadEnemyLeader(Team *enemyTeam);
+
+        CombatStatus act(Character *attacker, Character *victim);
+
+        bool recording() const {
+            return this->recorder != nullptr;
+        }
+
+        void recordAttack(ReplayEvent event, const Character *attacker, const Character *victim, int damage) const;
+
+        void recordAction(ReplayEvent event, const Character *actor, const Character *target) const;
+
+        // Records an event of fighters given by their roster slots, see ReplayRecorder::record.
+        void record(ReplayEvent event, std::size_t actor, std::size_t target, double x, double y) const {
+            if (this->recorder) {
+                this->recorder->record(event, this->replaySide, actor, target, x, y);
+            }
+        }
+
+        void printHeader(std::string &out) const;
+
+        // Told about every fighter joining the roster but the leader, who joins while the team is being constructed.
+        virtual void enlisted(Character * /*fighter*/) {}
 
     public:
+        static constexpr std::size_t MAX_FIGHTERS = 10;
+        static constexpr std::size_t UNLIMITED = std::numeric_limits<std::size_t>::max();
+        // Rosters smaller than this are searched with a plain scan.
+        static constexpr std::size_t INDEX_THRESHOLD = 64;
+
         Team(Character *leader);
 
+        Team(Character *leader, std::size_t capacity);
+
         Character *getLeader() const;
 
         const std::vector<Character *> &getFighters() const;
 
+        const std::vector<std::size_t> &getLiveSlots() const;
+
+        std::size_t getCapacity() const;
+
          virtual ~Team();
 
         void add(Character *fighter);
 
         Character *findClosestCharacter(const Point &location, const std::vector<Character *> &fighters) const;
 
-        virtual void attack(Team *enemyTeam);
+        Character *closestAlive(const Point &location) const;
+
+        void useVectorizedSearch(bool enabled);
+
+        bool usesVectorizedSearch() const;
+
+        void recordTo(ReplayRecorder *newRecorder, std::uint8_t side);
+
+        void fighterMoved(std::size_t slot, const Point &from, const Point &to) override;
+
+        void fighterDied(std::size_t slot) override;
+
+        void fighterRevived(std::size_t slot) override;
+
+        void fighterHit(std::size_t slot, int hitPoints) override;
+
+        void addWatcher(FighterObserver *watcher);
+
+        void removeWatcher(FighterObserver *watcher);
+
+        Character *volley(Team *enemyTeam);
+
+        CombatStatus tryVolley(Team *enemyTeam, Character *&victim);
+
+        void attack(Team *enemyTeam);
+
+        virtual CombatStatus tryAttack(Team *enemyTeam);
 
         int stillAlive() const;
 
         void setLeader(Character* newLeader);
 
-        virtual void print() ;
+        void print();
+
+        void print(std::ostream &out);
+
+        virtual void print(std::string &out) const;
 
         // Make tidy make me write this
         Team(const Team &) = delete;
@@ -1,6 +1,8 @@
 /**
  * @file Team2.hpp
- * @brief Contains the declaration of the Team2 class.
+ * @brief Contains the declaration of the Team2 strategy.
+ * The fighters act in the order they joined the team, whatever their type, and attack the enemy closest to the
+ * leader.
  * @date 15/05/23
  * @author Tomer Gozlan
  */
@@ -9,18 +11,10 @@
 #define COWBOY_VS_NINJA_B_TEAM2_HPP
 
 #include "Character.hpp"
-#include "Team.hpp"
+#include "StrategyTeam.hpp"
 
 namespace ariel {
-    class Team2 : public Team {
-
-    public:
-        Team2(Character *leader);
-
-        void attack(Team *enemyTeam) override;
-
-        void print() override;
-    };
+    using Team2 = StrategyTeam<NearestTargeting, RosterOrder>;
 }
 
 #endif //COWBOY_VS_NINJA_B_TEAM2_HPP
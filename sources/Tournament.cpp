@@ -0,0 +1,295 @@
+/**
+ * @file Tournament.cpp
+ * @brief Implementation of the Tournament class and of its report.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "Tournament.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include "BattleRunner.hpp"
+#include "BattleSnapshot.hpp"
+#include "Xoshiro256.hpp"
+
+namespace ariel {
+
+    namespace {
+        // The teams a worker keeps built between tiles, room for the rows and the columns of two tiles.
+        const std::size_t CACHE_CAPACITY = 4 * Tournament::TILE;
+        const double ELO_K = 32.0;
+        const double ELO_SCALE = 400.0;
+        const int ELO_PASSES = 20;
+
+        // The teams of the entrants a worker played last, each in the state it was built in while unused.
+        class TeamCache {
+        private:
+            struct Slot {
+                std::size_t entrant;
+                std::unique_ptr<Team> team;
+                std::size_t lastUse;
+            };
+
+            std::vector<Slot> slots;
+            std::size_t clock = 0;
+
+            static std::unique_ptr<Team> build(const std::vector<FighterSpec> &roster, TeamType strategy) {
+                std::unique_ptr<Team> team = createTeam(strategy, createFighter(roster.front()),
+                                                        std::max(Team::MAX_FIGHTERS, roster.size()));
+                for (std::size_t i = 1; i < roster.size(); i++) {
+                    team->add(createFighter(roster[i]));
+                }
+                return team;
+            }
+
+        public:
+            // Reset to the state of the teams before every battle.
+            BattleSnapshot snapshot;
+
+            Team &get(std::size_t entrant, const std::vector<FighterSpec> &roster, TeamType strategy) {
+                this->clock++;
+                for (Slot &slot: this->slots) {
+                    if (slot.entrant == entrant) {
+                        slot.lastUse = this->clock;
+                        return *slot.team;
+                    }
+                }
+                if (this->slots.size() < CACHE_CAPACITY) {
+                    this->slots.push_back(Slot{entrant, build(roster, strategy), this->clock});
+                    return *this->slots.back().team;
+                }
+                Slot &oldest = *std::min_element(this->slots.begin(), this->slots.end(),
+                                                 [](const Slot &first, const Slot &second) {
+                                                     return first.lastUse < second.lastUse;
+                                                 });
+                oldest.team.reset();
+                oldest = Slot{entrant, build(roster, strategy), this->clock};
+                return *oldest.team;
+            }
+        };
+    }
+
+/**
+ * @brief Checks if two entrants met: they are different rosters.
+ * @param first An entrant.
+ * @param second Another entrant.
+ * @return True if the entrants fought each other.
+ */
+    bool TournamentReport::played(std::size_t first, std::size_t second) const {
+        return this->entrants[first].roster != this->entrants[second].roster;
+    }
+
+/**
+ * @brief Counts the pairs of entrants that met.
+ * @return The number of pairings.
+ */
+    std::size_t TournamentReport::pairings() const {
+        std::size_t count = 0;
+        for (std::size_t first = 0; first < this->entrants.size(); first++) {
+            for (std::size_t second = first + 1; second < this->entrants.size(); second++) {
+                if (played(first, second)) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+/**
+ * @brief Counts the battles of the tournament.
+ * @return The number of battles played.
+ */
+    std::size_t TournamentReport::battles() const {
+        return pairings() * this->battlesPerPairing;
+    }
+
+/**
+ * @brief The number of battles an entrant won against another one.
+ * @param winner The entrant counted as the winner.
+ * @param loser The entrant counted as the loser.
+ * @return The number of battles.
+ */
+    std::uint32_t TournamentReport::winsOf(std::size_t winner, std::size_t loser) const {
+        return this->wins[winner * this->entrants.size() + loser];
+    }
+
+/**
+ * @brief The number of battles between two entrants that ended undecided.
+ * @param first An entrant.
+ * @param second Another entrant.
+ * @return The number of draws, 0 if they didn't meet.
+ */
+    std::uint32_t TournamentReport::drawsOf(std::size_t first, std::size_t second) const {
+        if (first == second || !played(first, second)) {
+            return 0;
+        }
+        return static_cast<std::uint32_t>(this->battlesPerPairing) - winsOf(first, second) - winsOf(second, first);
+    }
+
+/**
+ * @brief Orders the entrants by rating.
+ * @return The indexes of the entrants, the best rated first, ties in the order of the entrants.
+ */
+    std::vector<std::size_t> TournamentReport::ranking() const {
+        std::vector<std::size_t> order(this->entrants.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t first, std::size_t second) {
+            return this->ratings[first] > this->ratings[second];
+        });
+        return order;
+    }
+
+/**
+ * @brief Constructs a tournament without rosters.
+ * @param threadCount The number of worker threads, 0 means one per hardware thread.
+ */
+    Tournament::Tournament(std::size_t threadCount) : pool(threadCount) {}
+
+/**
+ * @brief Enters a roster in the tournament, once per strategy of the rules it will be played with.
+ * @param roster The fighters, the first being the leader.
+ * @return The index of the roster.
+ * @throws std::invalid_argument If the roster is empty.
+ */
+    std::size_t Tournament::addRoster(std::vector<FighterSpec> roster) {
+        if (roster.empty()) {
+            throw std::invalid_argument("Error: A team needs at least a leader.");
+        }
+        this->rosters.push_back(std::move(roster));
+        return this->rosters.size() - 1;
+    }
+
+/**
+ * @brief Getter for the number of rosters entered.
+ * @return The number of rosters.
+ */
+    std::size_t Tournament::rosterCount() const {
+        return this->rosters.size();
+    }
+
+/**
+ * @brief Plays the whole tournament: every entrant against every entrant of another roster, battlesPerPairing
+ * times, the entrant that comes first attacking first in the even battles and second in the odd ones.
+ * Battle k of the pairing of entrants i < j is seeded with BattleRunner::battleSeed(seed, (i * n + j) * M + k),
+ * n being the number of entrants and M the battles per pairing, and plays like BattleRunner::runBattle of the
+ * two rosters with that seed.
+ * @param rules The strategies, the jitter and the round limit.
+ * @param battlesPerPairing The number of battles of every pairing.
+ * @param seed The seed of the tournament.
+ * @return The win matrix and the ratings of the entrants.
+ * @throws std::invalid_argument If the rules have no strategy.
+ */
+    TournamentReport Tournament::run(const TournamentRules &rules, std::size_t battlesPerPairing,
+                                     std::uint64_t seed) {
+        if (rules.strategies.empty()) {
+            throw std::invalid_argument("Error: A tournament needs at least one strategy.");
+        }
+        TournamentReport report;
+        report.battlesPerPairing = battlesPerPairing;
+        for (std::size_t roster = 0; roster < this->rosters.size(); roster++) {
+            for (TeamType strategy: rules.strategies) {
+                report.entrants.push_back(Entrant{roster, strategy});
+            }
+        }
+        const std::size_t count = report.entrants.size();
+        report.wins.assign(count * count, 0);
+
+        // The tiles on and above the diagonal, each played by one worker
+        const std::size_t tileCount = (count + TILE - 1) / TILE;
+        std::vector<std::pair<std::size_t, std::size_t>> tiles;
+        for (std::size_t tileRow = 0; tileRow < tileCount; tileRow++) {
+            for (std::size_t tileColumn = tileRow; tileColumn < tileCount; tileColumn++) {
+                tiles.emplace_back(tileRow, tileColumn);
+            }
+        }
+        std::vector<TeamCache> caches(this->pool.size());
+        this->pool.parallelFor(tiles.size(), [&](std::size_t tile, std::size_t worker) {
+            TeamCache &cache = caches[worker];
+            const std::size_t rowEnd = std::min(count, (tiles[tile].first + 1) * TILE);
+            const std::size_t columnEnd = std::min(count, (tiles[tile].second + 1) * TILE);
+            for (std::size_t first = tiles[tile].first * TILE; first < rowEnd; first++) {
+                const std::size_t columnBegin = std::max(first + 1, tiles[tile].second * TILE);
+                for (std::size_t second = columnBegin; second < columnEnd; second++) {
+                    if (!report.played(first, second)) {
+                        continue;
+                    }
+                    const Entrant &entrantA = report.entrants[first];
+                    const Entrant &entrantB = report.entrants[second];
+                    Team &teamFirst = cache.get(first, this->rosters[entrantA.roster], entrantA.strategy);
+                    Team &teamSecond = cache.get(second, this->rosters[entrantB.roster], entrantB.strategy);
+                    cache.snapshot.capture(teamFirst, teamSecond);
+                    for (std::size_t battle = 0; battle < battlesPerPairing; battle++) {
+                        if (battle > 0) {
+                            cache.snapshot.restore(teamFirst, teamSecond);
+                        }
+                        const bool swapped = battle % 2 == 1;
+                        Team &teamA = swapped ? teamSecond : teamFirst;
+                        Team &teamB = swapped ? teamFirst : teamSecond;
+                        if (rules.jitter > 0) {
+                            Xoshiro256 generator(BattleRunner::battleSeed(
+                                    seed, (first * count + second) * battlesPerPairing + battle));
+                            for (const Team *team: {&teamA, &teamB}) {
+                                for (Character *fighter: team->getFighters()) {
+                                    double offsetX = generator.uniform(-rules.jitter, rules.jitter);
+                                    double offsetY = generator.uniform(-rules.jitter, rules.jitter);
+                                    Point location = fighter->getLocation();
+                                    fighter->setLocation(Point(location.getX() + offsetX, location.getY() + offsetY));
+                                }
+                            }
+                        }
+                        BattleOutcome outcome = BattleRunner::fight(teamA, teamB, rules.maxRounds);
+                        if (outcome.result != BattleResult::Draw) {
+                            bool firstWon = (outcome.result == BattleResult::TeamAWins) != swapped;
+                            report.wins[firstWon ? first * count + second : second * count + first]++;
+                        }
+                    }
+                    // Leaves both teams as they were built for their next pairing
+                    cache.snapshot.restore(teamFirst, teamSecond);
+                }
+            }
+        });
+        fitRatings(report);
+        return report;
+    }
+
+/**
+ * @brief Fits Elo ratings to the whole win matrix: starting from INITIAL_RATING, every pass moves all the ratings
+ * at once by ELO_K times the average amount by which the entrant outscored its expected score, a draw counting
+ * half a win. The ratings don't depend on the order the battles were played in.
+ * @param report The report whose ratings are computed from its wins.
+ */
+    void Tournament::fitRatings(TournamentReport &report) {
+        const std::size_t count = report.entrants.size();
+        report.ratings.assign(count, INITIAL_RATING);
+        if (report.battlesPerPairing == 0) {
+            return;
+        }
+        const auto battles = static_cast<double>(report.battlesPerPairing);
+        std::vector<double> surplus(count);
+        for (int pass = 0; pass < ELO_PASSES; pass++) {
+            this->pool.parallelFor(count, [&](std::size_t entrant, std::size_t /*worker*/) {
+                double total = 0.0;
+                std::size_t opponents = 0;
+                for (std::size_t opponent = 0; opponent < count; opponent++) {
+                    if (opponent == entrant || !report.played(entrant, opponent)) {
+                        continue;
+                    }
+                    double score = (report.winsOf(entrant, opponent) + 0.5 * report.drawsOf(entrant, opponent)) /
+                                   battles;
+                    double expected = 1.0 / (1.0 + std::pow(10.0, (report.ratings[opponent] -
+                                                                   report.ratings[entrant]) / ELO_SCALE));
+                    total += score - expected;
+                    opponents++;
+                }
+                surplus[entrant] = opponents == 0 ? 0.0 : total / static_cast<double>(opponents);
+            });
+            for (std::size_t entrant = 0; entrant < count; entrant++) {
+                report.ratings[entrant] += ELO_K * surplus[entrant];
+            }
+        }
+    }
+
+}
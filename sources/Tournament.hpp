@@ -0,0 +1,83 @@
+/**
+ * @file Tournament.hpp
+ * @brief Round-robin tournament of rosters under team strategies, to tune the composition of rosters.
+ * Every roster enters once per strategy, and every entrant meets every entrant of another roster a number of
+ * times, the two teams taking turns to attack first. The pairings are played in square tiles of the matrix spread
+ * over the worker threads. A worker builds the teams of a tile once and resets them between battles from a
+ * BattleSnapshot taken before the first, so the fighters are built once per tile instead of once per battle.
+ * Each battle plays exactly like BattleRunner::runBattle with the same seed, so the report only depends on the
+ * rosters, the rules and the seed.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_TOURNAMENT_HPP
+#define COWBOY_VS_NINJA_B_TOURNAMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Scenario.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace ariel {
+
+    struct TournamentRules {
+        // Every roster enters the tournament once with each of these strategies.
+        std::vector<TeamType> strategies{TeamType::Team, TeamType::Team2, TeamType::SmartTeam};
+        // Every fighter is displaced by up to this much on each axis, drawn from the battle seed.
+        double jitter = 0.0;
+        // A battle that is still undecided after this many rounds is scored as a draw.
+        int maxRounds = 1000;
+    };
+
+    struct Entrant {
+        std::size_t roster;
+        TeamType strategy;
+    };
+
+    struct TournamentReport {
+        std::vector<Entrant> entrants;
+        std::size_t battlesPerPairing = 0;
+        // wins[winner * entrants.size() + loser] counts the battles the winner won against the loser.
+        std::vector<std::uint32_t> wins;
+        // Elo ratings fitted to the whole matrix, indexed like the entrants.
+        std::vector<double> ratings;
+
+        bool played(std::size_t first, std::size_t second) const;
+
+        std::size_t pairings() const;
+
+        std::size_t battles() const;
+
+        std::uint32_t winsOf(std::size_t winner, std::size_t loser) const;
+
+        std::uint32_t drawsOf(std::size_t first, std::size_t second) const;
+
+        std::vector<std::size_t> ranking() const;
+    };
+
+    class Tournament {
+    public:
+        // The side of the square tiles of the pairing matrix, a worker builds twice this many teams per tile.
+        static constexpr std::size_t TILE = 16;
+        static constexpr double INITIAL_RATING = 1500.0;
+
+        explicit Tournament(std::size_t threadCount = 0);
+
+        std::size_t addRoster(std::vector<FighterSpec> roster);
+
+        std::size_t rosterCount() const;
+
+        TournamentReport run(const TournamentRules &rules, std::size_t battlesPerPairing, std::uint64_t seed);
+
+    private:
+        WorkStealingPool pool;
+        std::vector<std::vector<FighterSpec>> rosters;
+
+        void fitRatings(TournamentReport &report);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_TOURNAMENT_HPP
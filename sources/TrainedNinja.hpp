@@ -10,12 +10,13 @@
 
 #include "Ninja.hpp"
 #include "Character.hpp"
+#include "UnitStats.hpp"
 
 namespace ariel{
     class TrainedNinja : public Ninja {
     private:
-        static const int TRAINED_NINJA_SPEED = 12;
-        static const int TRAINED_NINJA_HIT_POINTS = 120;
+        static constexpr int TRAINED_NINJA_SPEED = TRAINED_NINJA_STATS.speed;
+        static constexpr int TRAINED_NINJA_HIT_POINTS = TRAINED_NINJA_STATS.hitPoints;
     public:
         TrainedNinja(const std::string &name, const Point &location) : Ninja(name, location, TRAINED_NINJA_SPEED,
                                                                              TRAINED_NINJA_HIT_POINTS) {}
@@ -0,0 +1,91 @@
+/**
+ * @file UnitStats.hpp
+ * @brief The stats of every kind of unit in one table usable at compile time: speed, hit points, damage per
+ * attack, magazine size and slash range. The unit classes take their constants from here, and scenario rosters
+ * and kernels can read them in constant expressions instead of repeating the numbers.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_UNITSTATS_HPP
+#define COWBOY_VS_NINJA_B_UNITSTATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ariel {
+
+    enum class UnitType : std::uint8_t {
+        Cowboy,
+        YoungNinja,
+        TrainedNinja,
+        OldNinja
+    };
+
+    struct UnitStats {
+        // The distance a ninja moves in a turn, 0 for a cowboy
+        int speed;
+        int hitPoints;
+        // The damage of a shot or a slash
+        int damage;
+        // The bullets of a full gun, 0 for a ninja
+        int magazine;
+        // A slash hits enemies strictly closer than this, 0 for a cowboy
+        double slashRange;
+    };
+
+    // Every kind of ninja slashes alike, only speed and hit points tell them apart
+    inline constexpr int NINJA_SLASH_DAMAGE = 40;
+    inline constexpr double NINJA_SLASH_RANGE = 1.0;
+
+    inline constexpr UnitStats COWBOY_STATS{0, 110, 10, 6, 0.0};
+    inline constexpr UnitStats YOUNG_NINJA_STATS{14, 100, NINJA_SLASH_DAMAGE, 0, NINJA_SLASH_RANGE};
+    inline constexpr UnitStats TRAINED_NINJA_STATS{12, 120, NINJA_SLASH_DAMAGE, 0, NINJA_SLASH_RANGE};
+    inline constexpr UnitStats OLD_NINJA_STATS{8, 150, NINJA_SLASH_DAMAGE, 0, NINJA_SLASH_RANGE};
+
+    // Indexed by UnitType
+    inline constexpr std::array<UnitStats, 4> UNIT_STATS{COWBOY_STATS, YOUNG_NINJA_STATS, TRAINED_NINJA_STATS,
+                                                         OLD_NINJA_STATS};
+
+    /**
+     * @brief The stats of a kind of unit.
+     * @param type The kind of unit.
+     * @return Its row of the table.
+     */
+    constexpr const UnitStats &statsOf(UnitType type) {
+        return UNIT_STATS[static_cast<std::size_t>(type)];
+    }
+
+    /**
+     * @brief The most hit points any kind of unit starts with, the upper bound of the hit points of a character.
+     * @return The maximum of the hit points column.
+     */
+    constexpr int maxHitPoints() {
+        int most = 0;
+        for (const UnitStats &stats: UNIT_STATS) {
+            most = stats.hitPoints > most ? stats.hitPoints : most;
+        }
+        return most;
+    }
+
+    /**
+     * @brief Checks that every ninja row slashes with the shared constants, which the attack loops read for any ninja.
+     * @return True if no ninja row has its own damage or slash range.
+     */
+    constexpr bool ninjasSlashAlike() {
+        for (const UnitStats &stats: UNIT_STATS) {
+            if (stats.speed > 0 && (stats.damage != NINJA_SLASH_DAMAGE || stats.slashRange != NINJA_SLASH_RANGE)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(ninjasSlashAlike(), "A ninja row with its own slash needs per-fighter damage in the attack loops.");
+
+    static_assert(maxHitPoints() == 150, "The hit points of a character are bounded by the toughest unit.");
+
+}
+
+#endif //COWBOY_VS_NINJA_B_UNITSTATS_HPP
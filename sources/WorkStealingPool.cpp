@@ -0,0 +1,200 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the WorkStealingPool class.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+namespace ariel {
+
+/**
+ * @brief Starts the worker threads of the pool.
+ * The thread calling parallelFor() is used as worker 0, so only threadCount - 1 background threads are started.
+ * @param threadCount The number of workers, 0 means one per hardware thread.
+ */
+    WorkStealingPool::WorkStealingPool(std::size_t threadCount) : grain(1), currentTask(nullptr), generation(0),
+                                                                  busyWorkers(0), stopping(false) {
+        if (threadCount == 0) {
+            threadCount = std::max(1U, std::thread::hardware_concurrency());
+        }
+        for (std::size_t i = 0; i < threadCount; i++) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (std::size_t worker = 1; worker < threadCount; worker++) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+        }
+    }
+
+/**
+ * @brief Stops and joins all the background workers.
+ */
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+    }
+
+/**
+ * @brief Getter for the number of workers, including the calling thread.
+ * @return The number of workers.
+ */
+    std::size_t WorkStealingPool::size() const {
+        return queues.size();
+    }
+
+/**
+ * @brief Runs task(i, worker) for every i in [0, count) and waits until all of them are done.
+ * The range is split evenly between the workers up front; idle workers then steal from busy ones.
+ * @param count The number of tasks.
+ * @param task The task body, it must be safe to call concurrently with different indices.
+ * @throws Rethrows the first exception thrown by a task, after all the other tasks have finished.
+ */
+    void WorkStealingPool::parallelFor(std::size_t count, const Task &task) {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t workers = queues.size();
+        const std::size_t piecesPerWorker = 16;
+        grain = std::max<std::size_t>(1, count / (workers * piecesPerWorker));
+        for (std::size_t worker = 0; worker < workers; worker++) {
+            std::size_t begin = count * worker / workers;
+            std::size_t end = count * (worker + 1) / workers;
+            if (begin < end) {
+                std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+                queues[worker]->ranges.push_back(Range{begin, end});
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            currentTask = &task;
+            failure = nullptr;
+            busyWorkers = threads.size();
+            generation++;
+        }
+        wakeUp.notify_all();
+
+        drain(0);
+
+        std::unique_lock<std::mutex> lock(controlMutex);
+        finished.wait(lock, [this] { return busyWorkers == 0; });
+        currentTask = nullptr;
+        if (failure) {
+            std::exception_ptr error = failure;
+            failure = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+/**
+ * @brief Takes the next grain of work from the front of the worker's own deque.
+ * @param worker The worker taking the work.
+ * @param range Receives the taken range.
+ * @return true if work was taken, false if the deque is empty.
+ */
+    bool WorkStealingPool::popLocal(std::size_t worker, Range &range) {
+        WorkQueue &queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.ranges.empty()) {
+            return false;
+        }
+        Range &front = queue.ranges.front();
+        range.begin = front.begin;
+        range.end = std::min(front.end, front.begin + grain);
+        front.begin = range.end;
+        if (front.begin == front.end) {
+            queue.ranges.pop_front();
+        }
+        return true;
+    }
+
+/**
+ * @brief Steals the upper half of the last range of another worker and queues it at the thief.
+ * @param thief The idle worker.
+ * @param range Receives the first grain of the stolen work.
+ * @return true if something was stolen, false if every deque is empty.
+ */
+    bool WorkStealingPool::steal(std::size_t thief, Range &range) {
+        const std::size_t workers = queues.size();
+        for (std::size_t offset = 1; offset < workers; offset++) {
+            WorkQueue &victim = *queues[(thief + offset) % workers];
+            Range stolen{0, 0};
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.ranges.empty()) {
+                    continue;
+                }
+                Range &back = victim.ranges.back();
+                std::size_t length = back.end - back.begin;
+                if (length <= grain) {
+                    stolen = back;
+                    victim.ranges.pop_back();
+                } else {
+                    stolen = Range{back.begin + length / 2, back.end};
+                    back.end = stolen.begin;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(queues[thief]->mutex);
+                queues[thief]->ranges.push_back(stolen);
+            }
+            return popLocal(thief, range);
+        }
+        return false;
+    }
+
+/**
+ * @brief Runs tasks until neither the worker's deque nor any other deque has work left.
+ * @param worker The worker running the tasks.
+ */
+    void WorkStealingPool::drain(std::size_t worker) {
+        const Task &task = *currentTask;
+        Range range{0, 0};
+        while (popLocal(worker, range) || steal(worker, range)) {
+            for (std::size_t index = range.begin; index < range.end; index++) {
+                try {
+                    task(index, worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(controlMutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+        }
+    }
+
+/**
+ * @brief The body of a background worker: sleeps until parallelFor() publishes new work, then drains it.
+ * @param worker The index of the worker.
+ */
+    void WorkStealingPool::workerLoop(std::size_t worker) {
+        std::size_t seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(controlMutex);
+                wakeUp.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+                if (stopping) {
+                    return;
+                }
+                seenGeneration = generation;
+            }
+            drain(worker);
+            {
+                std::lock_guard<std::mutex> lock(controlMutex);
+                busyWorkers--;
+                if (busyWorkers == 0) {
+                    finished.notify_all();
+                }
+            }
+        }
+    }
+
+}
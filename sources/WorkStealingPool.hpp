@@ -0,0 +1,81 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @brief A fixed set of worker threads that split index ranges between them and steal from each other.
+ * Every worker owns a deque of index ranges. It takes work from the front of its own deque and, once that is empty,
+ * steals half of the range at the back of another worker's deque, so uneven task lengths still keep all cores busy.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_WORKSTEALINGPOOL_HPP
+#define COWBOY_VS_NINJA_B_WORKSTEALINGPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ariel {
+
+    class WorkStealingPool {
+    public:
+        // Called with the task index and the index of the worker running it.
+        using Task = std::function<void(std::size_t, std::size_t)>;
+
+        explicit WorkStealingPool(std::size_t threadCount = 0);
+
+        ~WorkStealingPool();
+
+        std::size_t size() const;
+
+        void parallelFor(std::size_t count, const Task &task);
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        WorkStealingPool(WorkStealingPool &&) = delete;
+
+        WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+
+    private:
+        struct Range {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Range> ranges;
+        };
+
+        bool popLocal(std::size_t worker, Range &range);
+
+        bool steal(std::size_t thief, Range &range);
+
+        void drain(std::size_t worker);
+
+        void workerLoop(std::size_t worker);
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::vector<std::thread> threads;
+        std::size_t grain;
+
+        std::mutex controlMutex;
+        std::condition_variable wakeUp;
+        std::condition_variable finished;
+        const Task *currentTask;
+        std::size_t generation;
+        std::size_t busyWorkers;
+        bool stopping;
+        std::exception_ptr failure;
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_WORKSTEALINGPOOL_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file Xoshiro256.cpp
+ * @brief Implementation of the Xoshiro256 class, after the reference implementation of xoshiro256** and
+ * splitmix64 by David Blackman and Sebastiano Vigna.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#include "Xoshiro256.hpp"
+#include <stdexcept>
+
+namespace ariel {
+
+    namespace {
+        const std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+    }
+
+/**
+ * @brief Constructs a generator whose state is filled by splitmix64 from the seed, as recommended by the authors.
+ * @param seed Any value, 0 included.
+ */
+    Xoshiro256::Xoshiro256(std::uint64_t seed) : state() {
+        for (std::uint64_t &word: this->state) {
+            word = splitMix(seed);
+        }
+    }
+
+/**
+ * @brief Constructs the generator of one of the independent streams of a seed.
+ * @param seed The seed shared by all the streams.
+ * @param stream The index of the stream, e.g. of a battle or a worker thread.
+ */
+    Xoshiro256::Xoshiro256(std::uint64_t seed, std::uint64_t stream) : Xoshiro256(streamSeed(seed, stream)) {}
+
+/**
+ * @brief Draws the next 64 random bits.
+ * @return A value uniformly distributed over the 64 bit integers.
+ */
+    Xoshiro256::result_type Xoshiro256::operator()() {
+        const std::uint64_t result = rotateLeft(this->state[1] * 5, 7) * 9;
+        const std::uint64_t shifted = this->state[1] << 17;
+        this->state[2] ^= this->state[0];
+        this->state[3] ^= this->state[1];
+        this->state[1] ^= this->state[2];
+        this->state[0] ^= this->state[3];
+        this->state[2] ^= shifted;
+        this->state[3] = rotateLeft(this->state[3], 45);
+        return result;
+    }
+
+/**
+ * @brief Draws a double uniformly from [low, high) out of the top 53 bits of the next value.
+ * @param low The smallest value that can be drawn.
+ * @param high The bound of the range.
+ * @return The value.
+ */
+    double Xoshiro256::uniform(double low, double high) {
+        const double unit = static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+        return low + (high - low) * unit;
+    }
+
+/**
+ * @brief Draws an integer uniformly from [0, bound), rejecting the values that would bias the result.
+ * @param bound The number of possible values.
+ * @return The value.
+ * @throws std::invalid_argument If the bound is 0.
+ */
+    std::uint64_t Xoshiro256::below(std::uint64_t bound) {
+        if (bound == 0) {
+            throw std::invalid_argument("Error: Cannot draw from an empty range.");
+        }
+        // The values below 2^64 mod bound belong to an incomplete last range
+        const std::uint64_t threshold = (0 - bound) % bound;
+        while (true) {
+            std::uint64_t value = (*this)();
+            if (value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+
+/**
+ * @brief Advances the generator by 2^128 values, the same as that many calls, to split off non-overlapping
+ * sequences from a single generator.
+ */
+    void Xoshiro256::jump() {
+        static const std::uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+                                             0x39ABDC4529B1661CULL};
+        std::array<std::uint64_t, 4> jumped{};
+        for (std::uint64_t polynomial: JUMP) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (polynomial & (std::uint64_t{1} << bit)) {
+                    for (std::size_t i = 0; i < jumped.size(); i++) {
+                        jumped[i] ^= this->state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        this->state = jumped;
+    }
+
+/**
+ * @brief The splitmix64 generator: advances its state by the golden gamma and scrambles it.
+ * @param state The state of the splitmix64 generator, updated.
+ * @return The next value of the splitmix64 sequence.
+ */
+    std::uint64_t Xoshiro256::splitMix(std::uint64_t &state) {
+        state += GOLDEN_GAMMA;
+        std::uint64_t mixed = state;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+        return mixed ^ (mixed >> 31);
+    }
+
+/**
+ * @brief Derives the seed of one stream from a shared seed: value number stream + 1 of splitmix64 seeded with it,
+ * so neighbouring streams get unrelated seeds.
+ * @param seed The shared seed.
+ * @param stream The index of the stream.
+ * @return The seed of the stream.
+ */
+    std::uint64_t Xoshiro256::streamSeed(std::uint64_t seed, std::uint64_t stream) {
+        std::uint64_t state = seed + GOLDEN_GAMMA * stream;
+        return splitMix(state);
+    }
+
+}
@@ -0,0 +1,55 @@
+/**
+ * @file Xoshiro256.hpp
+ * @brief The xoshiro256** pseudo-random generator, seeded through splitmix64, for reproducible battles.
+ * Unlike std::default_random_engine and the standard distributions, the whole sequence (including the doubles
+ * it draws) is fully specified, so a seed gives bit-identical results on every compiler and platform.
+ * Independent streams are derived from a seed and a stream index, so every battle or worker thread draws from
+ * its own stream and the results don't depend on how the work was spread over threads.
+ * @author Tomer Gozlan
+ * @date 17/10/2026
+ */
+
+#ifndef COWBOY_VS_NINJA_B_XOSHIRO256_HPP
+#define COWBOY_VS_NINJA_B_XOSHIRO256_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace ariel {
+
+    class Xoshiro256 {
+    private:
+        std::array<std::uint64_t, 4> state;
+
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256(std::uint64_t seed);
+
+        Xoshiro256(std::uint64_t seed, std::uint64_t stream);
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()();
+
+        double uniform(double low, double high);
+
+        std::uint64_t below(std::uint64_t bound);
+
+        void jump();
+
+        static std::uint64_t splitMix(std::uint64_t &state);
+
+        static std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream);
+    };
+
+}
+
+#endif //COWBOY_VS_NINJA_B_XOSHIRO256_HPP
@@ -10,13 +10,14 @@
 
 #include "Ninja.hpp"
 #include "Character.hpp"
+#include "UnitStats.hpp"
 
 namespace ariel {
 
     class YoungNinja : public Ninja {
     private:
-        static const int YOUNG_NINJA_SPEED = 14;
-        static const int YOUNG_NINJA_HIT_POINTS = 100;
+        static constexpr int YOUNG_NINJA_SPEED = YOUNG_NINJA_STATS.speed;
+        static constexpr int YOUNG_NINJA_HIT_POINTS = YOUNG_NINJA_STATS.hitPoints;
 
     public:
         YoungNinja(const std::string &name, const Point &location) : Ninja(name, location, YOUNG_NINJA_SPEED,